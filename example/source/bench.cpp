@@ -1,12 +1,28 @@
 #include "util.hpp"
 
+#include "opt_iter/adapt.hpp"
+#include "opt_iter/algorithm.hpp"
+#include "opt_iter/arena.hpp"
+#include "opt_iter/callbacks.hpp"
+#include "opt_iter/coro.hpp"
+#include "opt_iter/drive.hpp"
 #include "opt_iter/opt_iter.hpp"
+#include "opt_iter/pool.hpp"
+#include "opt_iter/segmented.hpp"
+#include "opt_iter/simd.hpp"
+#include "opt_iter/soa.hpp"
+#include "opt_iter/view.hpp"
 
+#include <algorithm>
 #include <array>
 #include <generator>
 #include <limits>
+#include <numeric>
 #include <print>
 #include <random>
+#include <string>
+#include <string_view>
+#include <type_traits>
 
 #define ENABLE_SPECIAL_MEMBER_FUNCTIONS 0
 
@@ -96,14 +112,17 @@ public:
     FlatIndex(Ts... dims)
         : m_dims{ static_cast<Index>(dims)... }
         , m_current{}
+        , m_back{ static_cast<Index>(static_cast<Index>(dims) - 1)... }
+        , m_remaining{ (static_cast<std::size_t>(dims) * ...) }
     {
     }
 
     std::optional<std::array<Index, N>> next()
     {
-        if (m_current == m_dims) {
+        if (m_remaining == 0) {
             return std::nullopt;
         }
+        --m_remaining;
 
         auto prev = m_current;
 
@@ -119,18 +138,141 @@ public:
         return prev;
     }
 
-    void                 reset() { m_current = {}; }
+    std::optional<std::array<Index, N>> next_back()
+    {
+        if (m_remaining == 0) {
+            return std::nullopt;
+        }
+        --m_remaining;
+
+        auto prev = m_back;
+
+        for (auto i = 0u; i < N; ++i) {
+            if (m_back[i]-- == 0) {
+                m_back[i] = m_dims[i] - 1;
+            } else {
+                return prev;
+            }
+        }
+
+        return prev;
+    }
+
+    void reset()
+    {
+        m_current = {};
+        for (auto i = 0u; i < N; ++i) {
+            m_back[i] = m_dims[i] - 1;
+        }
+        m_remaining = 1;
+        for (auto dim : m_dims) {
+            m_remaining *= static_cast<std::size_t>(dim);
+        }
+    }
+
     std::array<Index, N> dims() const { return m_dims; }
     static Index         size() { return N; }
 
 private:
     std::array<Index, N> m_dims;
     std::array<Index, N> m_current;
+    std::array<Index, N> m_back;
+    std::size_t          m_remaining;
 };
 
 template <typename... Ts>
 FlatIndex(Ts...) -> FlatIndex<sizeof...(Ts)>;
 
+// 3x3 stencil offsets with the number of values known at compile time
+struct Stencil
+{
+    using static_size = std::integral_constant<std::size_t, 9>;
+
+    std::optional<std::array<int, 2>> next()
+    {
+        if (m_index >= static_size::value) {
+            return std::nullopt;
+        }
+        auto index = static_cast<int>(m_index++);
+        return std::array{ index % 3 - 1, index / 3 - 1 };
+    }
+
+    std::size_t m_index = 0;
+};
+
+// yields a fresh vector for each record
+struct RecordGen
+{
+    std::optional<std::vector<int>> next()
+    {
+        if (m_count++ >= m_limit) {
+            return std::nullopt;
+        }
+        auto record = std::vector<int>(64);
+        std::ranges::fill(record, static_cast<int>(m_count));
+        return record;
+    }
+
+    std::size_t m_count = 0;
+    std::size_t m_limit = 0;
+};
+
+// yields vectors recycled through a pool, no allocation at steady state
+struct PooledRecordGen
+{
+    std::optional<opt_iter::Pooled<std::vector<int>>> next()
+    {
+        if (m_count++ >= m_limit) {
+            return std::nullopt;
+        }
+        auto record = m_pool.acquire();
+        record->assign(64, static_cast<int>(m_count));
+        return record;
+    }
+
+    std::size_t                      m_count = 0;
+    std::size_t                      m_limit = 0;
+    opt_iter::Pool<std::vector<int>> m_pool  = {};
+};
+
+// synthesizes "key<i>=<i>" as a new string for each item
+struct KeyValueGen
+{
+    std::optional<std::string> next()
+    {
+        if (m_count >= m_limit) {
+            return std::nullopt;
+        }
+        auto number = std::to_string(m_count++);
+        return "key" + number + "=" + number;
+    }
+
+    std::size_t m_count = 0;
+    std::size_t m_limit = 0;
+};
+
+// synthesizes "key<i>=<i>" into an arena released by the consumer
+struct ArenaKeyValueGen
+{
+    std::optional<std::string_view> next()
+    {
+        if (m_count >= m_limit) {
+            return std::nullopt;
+        }
+        auto number  = std::to_string(m_count++);
+        auto builder = m_arena->builder();
+        builder.append("key");
+        builder.append(number);
+        builder.push_back('=');
+        builder.append(number);
+        return builder.finish();
+    }
+
+    std::size_t            m_count = 0;
+    std::size_t            m_limit = 0;
+    opt_iter::StringArena* m_arena = nullptr;
+};
+
 struct SeqUIntGen
 {
     // using call operator
@@ -162,6 +304,23 @@ std::generator<Val> rand_gen_2(std::mt19937& rng, std::size_t limit)
     }
 }
 
+opt_iter::Coro<Val> rand_gen_3(std::mt19937& rng, std::size_t limit)
+{
+    auto int_dist = std::uniform_int_distribution{
+        std::numeric_limits<int>::min(),
+        std::numeric_limits<int>::max(),
+    };
+    auto float_dist = std::uniform_real_distribution<float>{
+        std::numeric_limits<float>::min(),
+        std::numeric_limits<float>::max(),
+    };
+
+    auto count = 0u;
+    while (count++ < limit) {
+        co_yield Val{ int_dist(rng), float_dist(rng) };
+    }
+}
+
 template <std::size_t N, std::integral Index = std::size_t>
     requires (N > 0)
 std::generator<std::array<Index, N>> flat_index_2(const std::array<Index, N> dims)
@@ -193,13 +352,15 @@ int main()
     auto rng = std::mt19937{ std::random_device{}() };
     auto gen = RandGen{ rng, num_iter };
 
+    auto store = std::optional<Val>{};
+    auto range = opt_iter::make_with(store, gen);
+
     auto [time1, size1] = util::time_repeated(10, [&] {
-        auto store = std::optional<Val>{};
-        auto vec   = std::vector<Val>();
-        for (auto&& v : opt_iter::make_with(store, gen)) {
+        auto vec = std::vector<Val>();
+        for (auto&& v : range) {
             vec.push_back(std::move(v));
         }
-        gen.reset();
+        range.reset();
         return vec.size();
     });
     std::println("using opt_iter: {}, {}", time1, size1);
@@ -214,6 +375,69 @@ int main()
     });
     std::println("using while loop: {}, {}", time2, size2);
 
+    auto [time2_drive, size2_drive] = util::time_repeated(10, [&] {
+        auto vec = opt_iter::drive(gen, opt_iter::sink::into_vector());
+        gen.reset();
+        return vec.size();
+    });
+    std::println("using drive: {}, {}", time2_drive, size2_drive);
+
+    // a kernel over a single field: array of structs transposed before the kernel vs struct of arrays
+    auto [time2_aos, sum2_aos] = util::time_repeated(10, [&] {
+        auto vec = std::vector<Val>();
+        for (auto&& v : range) {
+            vec.push_back(std::move(v));
+        }
+        range.reset();
+
+        auto floats = std::vector<float>(vec.size());
+        std::ranges::transform(vec, floats.begin(), &Val::m_float);
+        return std::reduce(floats.begin(), floats.end(), 0.0);
+    });
+    std::println("array of structs, transposed: {}, {}", time2_aos, sum2_aos);
+
+    auto [time2_soa, sum2_soa] = util::time_repeated(10, [&] {
+        auto soa = opt_iter::collect_soa<&Val::m_int, &Val::m_float>(range);
+        range.reset();
+
+        auto floats = soa.column<1>();
+        return std::reduce(floats.begin(), floats.end(), 0.0);
+    });
+    std::println("struct of arrays: {}, {}", time2_soa, sum2_soa);
+
+    // collecting without relocation: time and the growth of the peak resident set size
+    auto [time2_to, size2_to] = util::time_repeated(10, [&] {
+        auto vec = range | std::ranges::to<std::vector>();
+        range.reset();
+        return vec.size();
+    });
+    std::println("using ranges::to<vector>: {}, {}", time2_to, size2_to);
+
+    auto [time2_seg, size2_seg] = util::time_repeated(10, [&] {
+        auto values = opt_iter::collect_segmented(range);
+        range.reset();
+        return values.size();
+    });
+    std::println("using collect_segmented: {}, {}", time2_seg, size2_seg);
+
+    auto peak_rss_growth = [&](auto collect) {
+        util::reset_peak_rss();
+        auto base = util::peak_rss_kib();
+        {
+            auto values = collect();
+            range.reset();
+        }
+        return util::peak_rss_kib() - base;
+    };
+
+    auto peak_to   = peak_rss_growth([&] { return range | std::ranges::to<std::vector>(); });
+    auto peak_seg  = peak_rss_growth([&] { return opt_iter::collect_segmented(range); });
+    auto peak_huge = peak_rss_growth([&] { return opt_iter::collect_segmented(range, opt_iter::Pages::Huge); });
+    std::println(
+        "peak RSS growth in KiB: ranges::to<vector> {}, segmented {}, segmented on huge pages {}", peak_to, peak_seg,
+        peak_huge
+    );
+
     gen.reset();
 
     auto [time3, size3] = util::time_repeated(10, [&] {
@@ -225,6 +449,41 @@ int main()
     });
     std::println("using std::generator: {}, {}", time3, size3);
 
+    auto [time3_coro, size3_coro] = util::time_repeated(10, [&] {
+        auto vec  = std::vector<Val>();
+        auto coro = rand_gen_3(rng, num_iter);
+        for (auto&& v : opt_iter::make(coro)) {
+            vec.push_back(std::move(v));
+        }
+        return vec.size();
+    });
+    std::println("using opt_iter::Coro: {}, {}", time3_coro, size3_coro);
+
+    // many short-lived coroutines: the frames of opt_iter::Coro are recycled
+    auto [time3_short, size3_short] = util::time_repeated(10, [&] {
+        auto size = 0uz;
+        for (auto _ : std::views::iota(0u, num_iter / 10)) {
+            for (auto&& v : rand_gen_2(rng, 10)) {
+                size += static_cast<std::size_t>(v.m_int & 1);
+            }
+        }
+        return size;
+    });
+    std::println("short-lived std::generator: {}, {}", time3_short, size3_short);
+
+    auto [time3_short_coro, size3_short_coro] = util::time_repeated(10, [&] {
+        auto size    = 0uz;
+        auto storage = opt_iter::traits::RefillOpt<Val>{};
+        for (auto _ : std::views::iota(0u, num_iter / 10)) {
+            auto coro = rand_gen_3(rng, 10);
+            for (auto&& v : opt_iter::make_with(storage, coro)) {
+                size += static_cast<std::size_t>(v.m_int & 1);
+            }
+        }
+        return size;
+    });
+    std::println("short-lived opt_iter::Coro: {}, {}", time3_short_coro, size3_short_coro);
+
     // an owned range
     auto iter = opt_iter::make_owned<SeqUIntGen>();
 
@@ -233,16 +492,64 @@ int main()
     std::println("using new gen: {}", util::take_elipsis(iter, 20));
     std::println("using new gen: {}", util::take_elipsis(iter, 20));
 
+    // lazy advance: next() is only called once the value is actually needed
+    auto eager = opt_iter::make_owned<SeqUIntGen>();
+    auto lazy  = opt_iter::make_owned<SeqUIntGen, opt_iter::Advance::Lazy>();
+
+    for (auto _ : std::views::iota(0, 4)) {
+        std::println("eager advance: {}", util::take_elipsis(eager, 20));
+        std::println("lazy advance : {}", util::take_elipsis(lazy, 20));
+    }
+    std::println(
+        "next() calls with take_elipsis: eager {}, lazy {}", eager.underlying().m_value, lazy.underlying().m_value
+    );
+
+    auto take_sum = [](auto& range) {
+        auto sum = 0uz;
+        for (auto v : range | std::views::take(10)) {
+            sum += static_cast<std::size_t>(v);
+        }
+        return sum;
+    };
+
+    eager.underlying().m_value = 0;
+    lazy.underlying().m_value  = 0;
+    eager.clear();
+    lazy.clear();
+
+    auto [time_eager, sum_eager] = util::time_repeated(10, [&] {
+        auto sum = 0uz;
+        for (auto _ : std::views::iota(0, 100'000)) {
+            sum += take_sum(eager);
+        }
+        return sum;
+    });
+    std::println("take(10) with eager advance: {}, {}", time_eager, sum_eager);
+
+    auto [time_lazy, sum_lazy] = util::time_repeated(10, [&] {
+        auto sum = 0uz;
+        for (auto _ : std::views::iota(0, 100'000)) {
+            sum += take_sum(lazy);
+        }
+        return sum;
+    });
+    std::println("take(10) with lazy advance: {}, {}", time_lazy, sum_lazy);
+    std::println(
+        "next() calls with take(10): eager {}, lazy {}", eager.underlying().m_value, lazy.underlying().m_value
+    );
+
     num_iter       = 200;
     auto flat_iter = FlatIndex{ num_iter, num_iter, num_iter };
 
+    auto flat_store = std::optional<std::array<std::size_t, 3>>{};
+    auto flat_range = opt_iter::make_with(flat_store, flat_iter);
+
     auto [time4, size4] = util::time_repeated(10, [&] {
-        auto store = std::optional<std::array<std::size_t, 3>>{};
-        auto vec   = std::vector<std::size_t>();
-        for (auto&& v : opt_iter::make_with(store, flat_iter)) {
+        auto vec = std::vector<std::size_t>();
+        for (auto&& v : flat_range) {
             vec.insert(vec.end(), v.begin(), v.end());
         }
-        flat_iter.reset();
+        flat_range.reset();
         return vec.size();
     });
     std::println("using opt_iter: {}, {}", time4, size4);
@@ -266,16 +573,262 @@ int main()
     });
     std::println("using std::generator: {}, {}", time6, size6);
 
+    // reverse scan: next_back() walks the indices from the back without materializing them first
+    auto [time7, size7] = util::time_repeated(10, [&] {
+        auto vec = std::vector<std::size_t>();
+        for (auto&& v : flat_range.rev()) {
+            vec.insert(vec.end(), v.begin(), v.end());
+        }
+        flat_range.reset();
+        return vec.size();
+    });
+    std::println("reversed using opt_iter rev(): {}, {}", time7, size7);
+
+    auto [time8, size8] = util::time_repeated(10, [&] {
+        auto indices = flat_range | std::ranges::to<std::vector>();
+        auto vec     = std::vector<std::size_t>();
+        for (auto&& v : indices | std::views::reverse) {
+            vec.insert(vec.end(), v.begin(), v.end());
+        }
+        flat_range.reset();
+        return vec.size();
+    });
+    std::println("reversed using collect + std::views::reverse: {}, {}", time8, size8);
+
     flat_iter.reset();
 
     std::println("FlatIndex with opt_iter:");
     for (auto [x, y, z] : opt_iter::make_owned<FlatIndex<3>>(3, 2, 3)) {
         std::println("({}, {}, {})", x, y, z);
     }
+    std::println("FlatIndex with opt_iter, from both ends:");
+    auto flat_owned = opt_iter::make_owned<FlatIndex<3>>(3, 2, 3);
+    for (auto [front, back] : flat_owned.ends()) {
+        if (back) {
+            std::println("{} {}", front, *back);
+        } else {
+            std::println("{}", front);
+        }
+    }
     std::println("FlatIndex with std::generator:");
     for (auto [x, y, z] : flat_index_2(std::array{ 3, 2, 3 })) {
         std::println("({}, {}, {})", x, y, z);
     }
 
+    // stencil with static size: the terminal operations are unrolled and the end is never checked
+    auto grid = std::vector<int>(1026 * 1026, 1);
+
+    auto stencil_sum = [&](auto sum_at) {
+        auto sum = 0uz;
+        for (auto y = 1; y < 1025; ++y) {
+            for (auto x = 1; x < 1025; ++x) {
+                sum += static_cast<std::size_t>(sum_at(x, y));
+            }
+        }
+        return sum;
+    };
+
+    auto [time9, sum9] = util::time_repeated(10, [&] {
+        return stencil_sum([&](int x, int y) {
+            auto stencil = Stencil{};
+            auto store   = std::optional<std::array<int, 2>>{};
+            auto sum     = 0;
+            for (auto [dx, dy] : opt_iter::make_with(store, stencil)) {
+                sum += grid[static_cast<std::size_t>((y + dy) * 1026 + x + dx)];
+            }
+            return sum;
+        });
+    });
+    std::println("stencil using range-for: {}, {}", time9, sum9);
+
+    auto [time10, sum10] = util::time_repeated(10, [&] {
+        return stencil_sum([&](int x, int y) {
+            auto stencil = Stencil{};
+            auto store   = std::optional<std::array<int, 2>>{};
+            return opt_iter::fold(opt_iter::make_with(store, stencil), 0, [&](int sum, std::array<int, 2> d) {
+                return sum + grid[static_cast<std::size_t>((y + d[1]) * 1026 + x + d[0])];
+            });
+        });
+    });
+    std::println("stencil using unrolled fold: {}, {}", time10, sum10);
+
+    // the int_gen pipeline: std::views over the range vs opt_iter::adapt over the OptIter itself
+    auto is_even  = [](int v) { return v % 2 == 0; };
+    auto negate   = [](int v) { return -v; };
+    auto num_take = 5'000'000uz;
+
+    auto [time11, sum11] = util::time_repeated(10, [&] {
+        auto seq = opt_iter::make_owned<SeqUIntGen>();
+        auto sum = 0uz;
+        for (auto v : seq | std::views::filter(is_even) | std::views::transform(negate) | std::views::take(num_take)) {
+            sum += static_cast<std::size_t>(-v);
+        }
+        return sum;
+    });
+    std::println("filter | transform | take using std::views: {}, {}", time11, sum11);
+
+    auto [time12, sum12] = util::time_repeated(10, [&] {
+        namespace adapt = opt_iter::adapt;
+
+        auto pipeline = SeqUIntGen{} | adapt::filter(is_even) | adapt::map(negate) | adapt::take(num_take);
+        auto sum      = 0uz;
+        for (auto v : opt_iter::make(pipeline)) {
+            sum += static_cast<std::size_t>(-v);
+        }
+        return sum;
+    });
+    std::println("filter | map | take using opt_iter::adapt: {}, {}", time12, sum12);
+
+    auto [time12_drive, sum12_drive] = util::time_repeated(10, [&] {
+        namespace sink = opt_iter::sink;
+
+        auto unsign = [](int v) { return static_cast<std::size_t>(-v); };
+        auto chain  = sink::filter(is_even) | sink::map(negate) | sink::take(num_take) | sink::map(unsign) | sink::sum();
+        return opt_iter::drive(SeqUIntGen{}, std::move(chain));
+    });
+    std::println("filter | map | take using opt_iter::drive: {}, {}", time12_drive, sum12_drive);
+
+    // push-style producer handed over from a helper thread, the cost per item depends on the buffer size
+    for (auto capacity : { 1uz, 64uz, 4096uz }) {
+        auto [time, sum] = util::time_repeated(10, [&] {
+            auto values = opt_iter::from_callbacks<int>(
+                [&](auto sink) {
+                    for (auto i = 0uz; i < num_take; ++i) {
+                        sink(static_cast<int>(i));
+                    }
+                },
+                capacity
+            );
+            auto sum = 0uz;
+            for (auto v : opt_iter::make(values)) {
+                sum += static_cast<std::size_t>(v);
+            }
+            return sum;
+        });
+        auto per_item = std::chrono::duration<double, std::nano>{ time } / static_cast<double>(num_take);
+        std::println("from_callbacks with capacity {}: {}, {} ({} per item)", capacity, time, sum, per_item);
+    }
+
+    // heavyweight values: fresh vector for each record vs recycled through a pool
+    auto [time_fresh, sum_fresh] = util::time_repeated(10, [&] {
+        auto sum = 0uz;
+        for (auto&& record : opt_iter::make_owned<RecordGen>(0uz, num_take)) {
+            sum += static_cast<std::size_t>(record.back());
+        }
+        return sum;
+    });
+    std::println("fresh vector records: {}, {}", time_fresh, sum_fresh);
+
+    auto [time_pooled, sum_pooled] = util::time_repeated(10, [&] {
+        auto sum = 0uz;
+        for (auto&& record : opt_iter::make_owned<PooledRecordGen>(0uz, num_take)) {
+            sum += static_cast<std::size_t>(record->back());
+        }
+        return sum;
+    });
+    std::println("pooled vector records: {}, {}", time_pooled, sum_pooled);
+
+    // synthesized text: a new string for each item vs views into an arena released per chunk of 1024 items
+    auto [time_string, sum_string] = util::time_repeated(10, [&] {
+        auto sum = 0uz;
+        for (auto chunk : opt_iter::chunks(opt_iter::make_owned<KeyValueGen>(0uz, num_take), 1024)) {
+            for (const auto& item : chunk) {
+                sum += item.size();
+            }
+        }
+        return sum;
+    });
+    std::println("std::string items: {}, {}", time_string, sum_string);
+
+    auto [time_arena, sum_arena] = util::time_repeated(10, [&] {
+        auto arena = opt_iter::StringArena{};
+        auto sum   = 0uz;
+        for (auto chunk : opt_iter::chunks(opt_iter::make_owned<ArenaKeyValueGen>(0uz, num_take, &arena), 1024)) {
+            for (auto item : chunk) {
+                sum += item.size();
+            }
+            arena.release();
+        }
+        return sum;
+    });
+    std::println("arena string_view items: {}, {}", time_arena, sum_arena);
+
+    // filtering arithmetic values: a branch per value vs a block at a time with SIMD, at several selectivities
+    auto scramble = [](int v) { return static_cast<unsigned>(v) * 2654435761u; };
+    for (auto selectivity : { 0.01, 0.1, 0.5, 0.9, 0.99 }) {
+        auto threshold = static_cast<unsigned>(selectivity * std::numeric_limits<unsigned>::max());
+        auto below     = [threshold](unsigned v) { return v < threshold; };
+        auto values    = [&] {
+            return SeqUIntGen{} | opt_iter::adapt::map(scramble) | opt_iter::adapt::take(num_take);
+        };
+
+        auto [time_views, sum_views] = util::time_repeated(10, [&] {
+            auto sum = 0uz;
+            for (auto v : opt_iter::make_owned<decltype(values())>(values()) | std::views::filter(below)) {
+                sum += v;
+            }
+            return sum;
+        });
+        std::println("selectivity {}: views::filter: {}, {}", selectivity, time_views, sum_views);
+
+        namespace simd = opt_iter::simd;
+        for (auto [isa, name] : { std::pair{ simd::Isa::Scalar, "scalar" }, { simd::Isa::Ssse3, "ssse3" },
+                                  { simd::Isa::Avx2, "avx2" } }) {
+            if (simd::use_isa(isa) != isa) {
+                continue;
+            }
+            auto [time_simd, sum_simd] = util::time_repeated(10, [&] {
+                auto sum = 0uz;
+                for (auto v : simd::filter(values(), simd::less(threshold))) {
+                    sum += v;
+                }
+                return sum;
+            });
+            auto [time_block, sum_block] = util::time_repeated(10, [&] {
+                auto sum    = 0uz;
+                auto filter = simd::filter(values(), simd::less(threshold));
+                for (auto block = filter.next_block(); not block.empty(); block = filter.next_block()) {
+                    sum = std::accumulate(block.begin(), block.end(), sum);
+                }
+                return sum;
+            });
+            std::println(
+                "selectivity {}: simd::filter ({}): {}, {}; by block: {}, {}", selectivity, name, time_simd,
+                sum_simd, time_block, sum_block
+            );
+        }
+        simd::use_isa(simd::supported_isa());
+    }
+
+    // rolling sum over windows of 8 values
+    auto rolling_sum = [](auto&& windows) {
+        auto sum = 0uz;
+        for (auto window : windows) {
+            for (auto v : window) {
+                sum += static_cast<std::size_t>(v);
+            }
+        }
+        return sum;
+    };
+
+    auto [time13, sum13] = util::time_repeated(10, [&] {
+        auto seq = SeqUIntGen{} | opt_iter::adapt::take(num_take);
+        return rolling_sum(opt_iter::windows<8>(opt_iter::make(seq)));
+    });
+    std::println("rolling sum using windows<8>: {}, {}", time13, sum13);
+
+    auto [time14, sum14] = util::time_repeated(10, [&] {
+        auto seq = SeqUIntGen{} | opt_iter::adapt::take(num_take);
+        return rolling_sum(opt_iter::windows(opt_iter::make(seq), 8));
+    });
+    std::println("rolling sum using windows(8): {}, {}", time14, sum14);
+
+    auto [time15, sum15] = util::time_repeated(10, [&] {
+        auto seq    = SeqUIntGen{} | opt_iter::adapt::take(num_take);
+        auto values = opt_iter::make(seq) | std::ranges::to<std::vector>();
+        return rolling_sum(values | std::views::slide(8));
+    });
+    std::println("rolling sum using collect + std::views::slide: {}, {}", time15, sum15);
+
     return 0;
 }
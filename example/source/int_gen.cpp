@@ -1,3 +1,4 @@
+#include "opt_iter/adapt.hpp"
 #include "opt_iter/opt_iter.hpp"
 
 #include <print>
@@ -22,9 +23,6 @@ struct IntGen
     std::uniform_int_distribution<int> m_int_dist;
 };
 
-// OptIter is required to be movable if it is to be wrapped by OwnedRange or OwnedRangeFunctor.
-static_assert(std::movable<IntGen>);
-
 int main()
 {
     auto rng = std::mt19937{ std::random_device{}() };
@@ -54,5 +52,14 @@ int main()
     std::println("\n> collect into vector");
     auto ten_int = gen | std::views::take(10) | std::ranges::to<std::vector>();
 
+    // the same pipeline on the OptIter itself, the whole pipeline is a single OptIter
+    std::println("\n> using opt_iter::adapt");
+    namespace adapt = opt_iter::adapt;
+
+    auto pipeline = IntGen{ &rng } | adapt::filter(is_even) | adapt::map(negate) | adapt::take(10);
+    for (auto v : opt_iter::make(pipeline)) {
+        std::println("v = {}", v);
+    }
+
     // etc...
 }
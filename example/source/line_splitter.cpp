@@ -1,8 +1,11 @@
+#include <opt_iter/algorithm.hpp>
 #include <opt_iter/opt_iter.hpp>
+#include <opt_iter/view.hpp>
 
 #include <filesystem>
 #include <fstream>
 #include <print>
+#include <random>
 #include <ranges>
 #include <sstream>
 
@@ -43,6 +46,17 @@ public:
         return result;
     }
 
+    // skips the lines without creating the string_view for them
+    std::size_t skip(std::size_t n)
+    {
+        auto skipped = 0uz;
+        for (; skipped < n and m_pos != std::string_view::npos; ++skipped) {
+            auto next_pos = m_str.find(m_delim, m_pos);
+            m_pos         = next_pos == std::string_view::npos ? next_pos : next_pos + 1;
+        }
+        return skipped;
+    }
+
     void        reset() { m_pos = 0; }
     std::size_t pos() const { return m_pos; }
 
@@ -52,6 +66,21 @@ private:
     char             m_delim;
 };
 
+// refills the same string for each line, the buffer is reused for the whole stream
+class LineReader
+{
+public:
+    LineReader(const fs::path& path)
+        : m_file{ path }
+    {
+    }
+
+    bool next(std::string& line) { return static_cast<bool>(std::getline(m_file, line)); }
+
+private:
+    std::ifstream m_file;
+};
+
 int main()
 {
     auto string   = file_read(__FILE__);
@@ -60,4 +89,25 @@ int main()
     for (auto&& [i, line] : splitter | std::views::enumerate) {
         std::println("{:>8} | {}", i + 1, line);
     }
+
+    auto reader = opt_iter::make_owned<LineReader>(__FILE__);
+    auto count  = 0uz;
+    for (const auto& line : reader) {
+        count += line.size();
+    }
+    std::println("total characters (excluding newlines): {}", count);
+
+    // sample 5 random lines, the lines in between are skipped
+    auto rng = std::mt19937{ std::random_device{}() };
+    splitter.reset();
+    for (auto line : opt_iter::sample(splitter.underlying(), 5, rng)) {
+        std::println("sampled: {}", line);
+    }
+
+    // group consecutive lines by their indentation without collecting them first
+    auto indent = [](const std::string& line) { return line.find_first_not_of(' '); };
+    auto lines  = opt_iter::make_owned<LineReader>(__FILE__);
+    for (auto group : opt_iter::group_by(lines, indent)) {
+        std::println("{} line(s) with indentation {}", std::ranges::distance(group), group.key());
+    }
 }
@@ -2,7 +2,13 @@
 
 #include <chrono>
 #include <format>
+#include <fstream>
 #include <ranges>
+#include <string>
+
+#if defined(__GLIBC__)
+#    include <malloc.h>
+#endif
 
 namespace util
 {
@@ -26,6 +32,30 @@ namespace util
         return TakeElipsis<R>{ std::forward<R>(range), limit };
     }
 
+    // resets the peak resident set size of the process, Linux only
+    inline void reset_peak_rss()
+    {
+#if defined(__GLIBC__)
+        // return the freed memory to the system first so that it doesn't hide the growth
+        malloc_trim(0);
+#endif
+        auto clear_refs = std::ofstream{ "/proc/self/clear_refs" };
+        clear_refs << "5";
+    }
+
+    // the peak resident set size of the process in KiB since the last reset, 0 if unavailable
+    inline std::size_t peak_rss_kib()
+    {
+        auto status = std::ifstream{ "/proc/self/status" };
+        auto line   = std::string{};
+        while (std::getline(status, line)) {
+            if (line.starts_with("VmHWM:")) {
+                return std::stoull(line.substr(6));
+            }
+        }
+        return 0;
+    }
+
     std::pair<Ms, std::size_t> time_repeated(std::size_t count, std::invocable auto fn)
     {
         using Clock = std::chrono::steady_clock;
@@ -0,0 +1,741 @@
+#ifndef OPT_ITER_ADAPT_HPP
+#define OPT_ITER_ADAPT_HPP
+
+#include "traits.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <random>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/**
+ * Adaptors that work on the `OptIter` itself instead of on the range.
+ *
+ * Each adaptor is a plain `OptIter` whose `next()` directly calls the `next()` (or `operator()()`) of its
+ * parent, so a whole pipeline is a single `OptIter` that can be wrapped with `opt_iter::make()` or
+ * `opt_iter::make_owned()` and iterated with a single storage. The parent is owned by the adaptor if it's
+ * passed as an rvalue and referenced if it's passed as an lvalue.
+ *
+ * ```cpp
+ * auto pipeline = IntGen{ &rng } | adapt::filter(is_even) | adapt::map(negate) | adapt::take(10);
+ * for (auto v : opt_iter::make(pipeline)) { ... }
+ * ```
+ */
+namespace opt_iter::adapt
+{
+    /**
+     * @brief Checks if a type can be the parent of an adaptor: `next()` or `operator()()` that returns an
+     * optional-like type.
+     *
+     * @tparam P The type of the parent, can be an lvalue reference.
+     */
+    template <typename P>
+    concept Parent = traits::HasNext<std::remove_cvref_t<P>> or traits::HasCallOp<std::remove_cvref_t<P>>;
+
+    namespace detail
+    {
+        template <Parent P>
+        using Opt = traits::OptIterTrait<std::remove_cvref_t<P>>::Opt;
+
+        template <Parent P>
+        using Ret = traits::OptIterTrait<std::remove_cvref_t<P>>::Ret;
+
+        template <Parent P>
+        Opt<P> pull(std::remove_cvref_t<P>& parent)
+        {
+            if constexpr (traits::HasNext<std::remove_cvref_t<P>>) {
+                return parent.next();
+            } else {
+                return parent();
+            }
+        }
+
+        template <traits::OptLike O>
+        bool has_value(const O& opt)
+        {
+            return traits::OptTrait<O>::has_value(opt);
+        }
+
+        /**
+         * @brief Drop the next `n` values of the parent, using its `skip()` if it has one.
+         *
+         * @return The number of values skipped, less than `n` if the parent is exhausted.
+         */
+        template <Parent P>
+        std::size_t skip(std::remove_cvref_t<P>& parent, std::size_t n)
+        {
+            if constexpr (traits::HasSkip<std::remove_cvref_t<P>>) {
+                return static_cast<std::size_t>(parent.skip(n));
+            } else {
+                for (auto i = std::size_t{ 0 }; i < n; ++i) {
+                    if (not has_value(pull<P>(parent))) {
+                        return i;
+                    }
+                }
+                return n;
+            }
+        }
+
+        /**
+         * @brief Number of failures before the first success of Bernoulli trials with `log(1 - p)`.
+         */
+        template <std::uniform_random_bit_generator G>
+        std::size_t geometric_gap(G& rng, double log_q)
+        {
+            auto dist = std::uniform_real_distribution<double>{ std::nextafter(0.0, 1.0), 1.0 };
+            auto gap  = std::floor(std::log(dist(rng)) / log_q);
+
+            constexpr auto max = static_cast<double>(std::numeric_limits<std::size_t>::max() / 2);
+            return gap >= max ? static_cast<std::size_t>(max) : static_cast<std::size_t>(gap);
+        }
+
+        template <traits::OptLike O>
+        auto& get(O& opt)
+        {
+            return traits::OptTrait<O>::get(opt);
+        }
+
+        /**
+         * @brief Adaptor with its arguments bound, waiting for the parent: `parent | adapt::take(10)`.
+         */
+        template <typename Make>
+        struct [[nodiscard]] Closure
+        {
+            Make make;
+
+            template <Parent P>
+            friend auto operator|(P&& parent, Closure closure)
+            {
+                return std::move(closure.make)(std::forward<P>(parent));
+            }
+        };
+
+        template <typename Make>
+        Closure(Make) -> Closure<Make>;
+    }
+
+    /**
+     * @class Map
+     *
+     * @brief Yields the values of the parent transformed by a function.
+     *
+     * @tparam P The type of the parent, can be an lvalue reference to not own the parent.
+     * @tparam Fn The type of the function.
+     */
+    template <Parent P, std::invocable<detail::Ret<P>&&> Fn>
+    class [[nodiscard]] Map
+    {
+    public:
+        using Ret = std::remove_cvref_t<std::invoke_result_t<Fn&, detail::Ret<P>&&>>;
+
+        Map(P parent, Fn fn)
+            : m_parent{ std::forward<P>(parent) }
+            , m_fn{ std::move(fn) }
+        {
+        }
+
+        std::optional<Ret> next()
+        {
+            auto value = detail::pull<P>(m_parent);
+            if (not detail::has_value(value)) {
+                return std::nullopt;
+            }
+            return std::invoke(m_fn, std::move(detail::get(value)));
+        }
+
+        std::size_t skip(std::size_t n)
+            requires traits::HasSkip<std::remove_cvref_t<P>>
+        {
+            return m_parent.skip(n);
+        }
+
+        void reset()
+            requires traits::HasReset<std::remove_cvref_t<P>>
+        {
+            m_parent.reset();
+        }
+
+    private:
+        P  m_parent;
+        Fn m_fn;
+    };
+
+    /**
+     * @class Filter
+     *
+     * @brief Yields the values of the parent that satisfy a predicate.
+     *
+     * @tparam P The type of the parent, can be an lvalue reference to not own the parent.
+     * @tparam Pred The type of the predicate.
+     */
+    template <Parent P, std::predicate<const detail::Ret<P>&> Pred>
+    class [[nodiscard]] Filter
+    {
+    public:
+        Filter(P parent, Pred pred)
+            : m_parent{ std::forward<P>(parent) }
+            , m_pred{ std::move(pred) }
+        {
+        }
+
+        detail::Opt<P> next()
+        {
+            auto value = detail::pull<P>(m_parent);
+            while (detail::has_value(value) and not std::invoke(m_pred, std::as_const(detail::get(value)))) {
+                value = detail::pull<P>(m_parent);
+            }
+            return value;
+        }
+
+        void reset()
+            requires traits::HasReset<std::remove_cvref_t<P>>
+        {
+            m_parent.reset();
+        }
+
+    private:
+        P    m_parent;
+        Pred m_pred;
+    };
+
+    /**
+     * @class FilterMap
+     *
+     * @brief Yields the values of the parent transformed by a function that returns an optional-like type,
+     * empty results are skipped.
+     *
+     * @tparam P The type of the parent, can be an lvalue reference to not own the parent.
+     * @tparam Fn The type of the function.
+     */
+    template <Parent P, std::invocable<detail::Ret<P>&&> Fn>
+        requires traits::OptLike<std::invoke_result_t<Fn&, detail::Ret<P>&&>>
+    class [[nodiscard]] FilterMap
+    {
+    public:
+        using Opt = std::invoke_result_t<Fn&, detail::Ret<P>&&>;
+
+        FilterMap(P parent, Fn fn)
+            : m_parent{ std::forward<P>(parent) }
+            , m_fn{ std::move(fn) }
+        {
+        }
+
+        Opt next()
+        {
+            while (true) {
+                auto value = detail::pull<P>(m_parent);
+                if (not detail::has_value(value)) {
+                    return Opt{};
+                }
+
+                auto mapped = std::invoke(m_fn, std::move(detail::get(value)));
+                if (detail::has_value(mapped)) {
+                    return mapped;
+                }
+            }
+        }
+
+        void reset()
+            requires traits::HasReset<std::remove_cvref_t<P>>
+        {
+            m_parent.reset();
+        }
+
+    private:
+        P  m_parent;
+        Fn m_fn;
+    };
+
+    /**
+     * @class Take
+     *
+     * @brief Yields at most the first `count` values of the parent.
+     *
+     * @tparam P The type of the parent, can be an lvalue reference to not own the parent.
+     *
+     * The parent is not called anymore once `count` values are taken.
+     */
+    template <Parent P>
+    class [[nodiscard]] Take
+    {
+    public:
+        Take(P parent, std::size_t count)
+            : m_parent{ std::forward<P>(parent) }
+            , m_count{ count }
+            , m_remaining{ count }
+        {
+        }
+
+        detail::Opt<P> next()
+        {
+            if (m_remaining == 0) {
+                return {};
+            }
+            --m_remaining;
+            return detail::pull<P>(m_parent);
+        }
+
+        std::size_t skip(std::size_t n)
+            requires traits::HasSkip<std::remove_cvref_t<P>>
+        {
+            auto skipped  = m_parent.skip(std::min(n, m_remaining));
+            m_remaining  -= skipped;
+            return skipped;
+        }
+
+        void reset()
+            requires traits::HasReset<std::remove_cvref_t<P>>
+        {
+            m_parent.reset();
+            m_remaining = m_count;
+        }
+
+    private:
+        P           m_parent;
+        std::size_t m_count;
+        std::size_t m_remaining;
+    };
+
+    /**
+     * @class TakeWhile
+     *
+     * @brief Yields the values of the parent until the first value that doesn't satisfy a predicate.
+     *
+     * @tparam P The type of the parent, can be an lvalue reference to not own the parent.
+     * @tparam Pred The type of the predicate.
+     *
+     * The first value that doesn't satisfy the predicate is consumed from the parent and dropped.
+     */
+    template <Parent P, std::predicate<const detail::Ret<P>&> Pred>
+    class [[nodiscard]] TakeWhile
+    {
+    public:
+        TakeWhile(P parent, Pred pred)
+            : m_parent{ std::forward<P>(parent) }
+            , m_pred{ std::move(pred) }
+        {
+        }
+
+        detail::Opt<P> next()
+        {
+            if (m_done) {
+                return {};
+            }
+
+            auto value = detail::pull<P>(m_parent);
+            if (detail::has_value(value) and std::invoke(m_pred, std::as_const(detail::get(value)))) {
+                return value;
+            }
+
+            m_done = true;
+            return {};
+        }
+
+        void reset()
+            requires traits::HasReset<std::remove_cvref_t<P>>
+        {
+            m_parent.reset();
+            m_done = false;
+        }
+
+    private:
+        P    m_parent;
+        Pred m_pred;
+        bool m_done = false;
+    };
+
+    /**
+     * @class SkipWhile
+     *
+     * @brief Skips the values of the parent while they satisfy a predicate, then yields the rest.
+     *
+     * @tparam P The type of the parent, can be an lvalue reference to not own the parent.
+     * @tparam Pred The type of the predicate.
+     */
+    template <Parent P, std::predicate<const detail::Ret<P>&> Pred>
+    class [[nodiscard]] SkipWhile
+    {
+    public:
+        SkipWhile(P parent, Pred pred)
+            : m_parent{ std::forward<P>(parent) }
+            , m_pred{ std::move(pred) }
+        {
+        }
+
+        detail::Opt<P> next()
+        {
+            auto value = detail::pull<P>(m_parent);
+            if (m_skipping) {
+                while (detail::has_value(value) and std::invoke(m_pred, std::as_const(detail::get(value)))) {
+                    value = detail::pull<P>(m_parent);
+                }
+                m_skipping = false;
+            }
+            return value;
+        }
+
+        void reset()
+            requires traits::HasReset<std::remove_cvref_t<P>>
+        {
+            m_parent.reset();
+            m_skipping = true;
+        }
+
+    private:
+        P    m_parent;
+        Pred m_pred;
+        bool m_skipping = true;
+    };
+
+    /**
+     * @class Enumerate
+     *
+     * @brief Yields the values of the parent paired with their index.
+     *
+     * @tparam P The type of the parent, can be an lvalue reference to not own the parent.
+     */
+    template <Parent P>
+    class [[nodiscard]] Enumerate
+    {
+    public:
+        using Ret = std::pair<std::size_t, detail::Ret<P>>;
+
+        Enumerate(P parent)
+            : m_parent{ std::forward<P>(parent) }
+        {
+        }
+
+        std::optional<Ret> next()
+        {
+            auto value = detail::pull<P>(m_parent);
+            if (not detail::has_value(value)) {
+                return std::nullopt;
+            }
+            return Ret{ m_index++, std::move(detail::get(value)) };
+        }
+
+        std::size_t skip(std::size_t n)
+            requires traits::HasSkip<std::remove_cvref_t<P>>
+        {
+            auto skipped  = m_parent.skip(n);
+            m_index      += skipped;
+            return skipped;
+        }
+
+        void reset()
+            requires traits::HasReset<std::remove_cvref_t<P>>
+        {
+            m_parent.reset();
+            m_index = 0;
+        }
+
+    private:
+        P           m_parent;
+        std::size_t m_index = 0;
+    };
+
+    /**
+     * @class Scan
+     *
+     * @brief Yields the results of a function that is called with a state and each value of the parent.
+     *
+     * @tparam P The type of the parent, can be an lvalue reference to not own the parent.
+     * @tparam S The type of the state, only needs to be copyable for `reset()`.
+     * @tparam Fn The type of the function, `fn(state&, value)` that returns an optional-like type.
+     *
+     * The iteration ends when the parent ends or the function returns an empty value.
+     */
+    template <Parent P, std::movable S, std::invocable<S&, detail::Ret<P>&&> Fn>
+        requires traits::OptLike<std::invoke_result_t<Fn&, S&, detail::Ret<P>&&>>
+    class [[nodiscard]] Scan
+    {
+        // the initial state is only kept around when it can be restored by reset()
+        using Init = std::conditional_t<std::copyable<S>, S, std::tuple<>>;
+
+    public:
+        using Opt = std::invoke_result_t<Fn&, S&, detail::Ret<P>&&>;
+
+        Scan(P parent, S init, Fn fn)
+            : m_parent{ std::forward<P>(parent) }
+            , m_init{ keep_init(init) }
+            , m_state{ std::move(init) }
+            , m_fn{ std::move(fn) }
+        {
+        }
+
+        Opt next()
+        {
+            if (m_done) {
+                return Opt{};
+            }
+
+            auto value = detail::pull<P>(m_parent);
+            if (detail::has_value(value)) {
+                auto result = std::invoke(m_fn, m_state, std::move(detail::get(value)));
+                if (detail::has_value(result)) {
+                    return result;
+                }
+            }
+
+            m_done = true;
+            return Opt{};
+        }
+
+        const S& state() const { return m_state; }
+
+        void reset()
+            requires traits::HasReset<std::remove_cvref_t<P>> and std::copyable<S>
+        {
+            m_parent.reset();
+            m_state = m_init;
+            m_done  = false;
+        }
+
+    private:
+        static Init keep_init(const S& init)
+        {
+            if constexpr (std::copyable<S>) {
+                return init;
+            } else {
+                return std::tuple<>{};
+            }
+        }
+
+        P                          m_parent;
+        [[no_unique_address]] Init m_init;
+        S                          m_state;
+        Fn                         m_fn;
+        bool                       m_done = false;
+    };
+
+    /**
+     * @class Inspect
+     *
+     * @brief Calls a function with each value of the parent before yielding it unchanged.
+     *
+     * @tparam P The type of the parent, can be an lvalue reference to not own the parent.
+     * @tparam Fn The type of the function.
+     */
+    template <Parent P, std::invocable<const detail::Ret<P>&> Fn>
+    class [[nodiscard]] Inspect
+    {
+    public:
+        Inspect(P parent, Fn fn)
+            : m_parent{ std::forward<P>(parent) }
+            , m_fn{ std::move(fn) }
+        {
+        }
+
+        detail::Opt<P> next()
+        {
+            auto value = detail::pull<P>(m_parent);
+            if (detail::has_value(value)) {
+                std::invoke(m_fn, std::as_const(detail::get(value)));
+            }
+            return value;
+        }
+
+        void reset()
+            requires traits::HasReset<std::remove_cvref_t<P>>
+        {
+            m_parent.reset();
+        }
+
+    private:
+        P  m_parent;
+        Fn m_fn;
+    };
+
+    /**
+     * @class Bernoulli
+     *
+     * @brief Yields each value of the parent independently with probability `p`.
+     *
+     * @tparam P The type of the parent, can be an lvalue reference to not own the parent.
+     * @tparam G The type of the random number generator, referenced by the adaptor.
+     *
+     * Instead of drawing a random number for each value, the gap to the next selected value is drawn from
+     * the geometric distribution and skipped at once, using the parent's `skip()` if it has one.
+     */
+    template <Parent P, std::uniform_random_bit_generator G>
+    class [[nodiscard]] Bernoulli
+    {
+    public:
+        Bernoulli(P parent, double p, G& rng)
+            : m_parent{ std::forward<P>(parent) }
+            , m_log_q{ std::log1p(-std::clamp(p, 0.0, 1.0)) }
+            , m_rng{ &rng }
+        {
+        }
+
+        detail::Opt<P> next()
+        {
+            if (m_log_q == -std::numeric_limits<double>::infinity()) {
+                return detail::pull<P>(m_parent);
+            }
+            if (m_log_q == 0.0) {
+                return {};
+            }
+
+            auto gap = detail::geometric_gap(*m_rng, m_log_q);
+            if (detail::skip<P>(m_parent, gap) < gap) {
+                return {};
+            }
+            return detail::pull<P>(m_parent);
+        }
+
+        void reset()
+            requires traits::HasReset<std::remove_cvref_t<P>>
+        {
+            m_parent.reset();
+        }
+
+    private:
+        P      m_parent;
+        double m_log_q;
+        G*     m_rng;
+    };
+
+    template <Parent P, typename Fn>
+    auto map(P&& parent, Fn fn)
+    {
+        return Map<P, Fn>{ std::forward<P>(parent), std::move(fn) };
+    }
+
+    template <typename Fn>
+    auto map(Fn fn)
+    {
+        return detail::Closure{ [fn = std::move(fn)]<Parent P>(P&& parent) mutable {
+            return map(std::forward<P>(parent), std::move(fn));
+        } };
+    }
+
+    template <Parent P, typename Pred>
+    auto filter(P&& parent, Pred pred)
+    {
+        return Filter<P, Pred>{ std::forward<P>(parent), std::move(pred) };
+    }
+
+    template <typename Pred>
+    auto filter(Pred pred)
+    {
+        return detail::Closure{ [pred = std::move(pred)]<Parent P>(P&& parent) mutable {
+            return filter(std::forward<P>(parent), std::move(pred));
+        } };
+    }
+
+    template <Parent P, typename Fn>
+    auto filter_map(P&& parent, Fn fn)
+    {
+        return FilterMap<P, Fn>{ std::forward<P>(parent), std::move(fn) };
+    }
+
+    template <typename Fn>
+    auto filter_map(Fn fn)
+    {
+        return detail::Closure{ [fn = std::move(fn)]<Parent P>(P&& parent) mutable {
+            return filter_map(std::forward<P>(parent), std::move(fn));
+        } };
+    }
+
+    template <Parent P>
+    auto take(P&& parent, std::size_t count)
+    {
+        return Take<P>{ std::forward<P>(parent), count };
+    }
+
+    inline auto take(std::size_t count)
+    {
+        return detail::Closure{ [count]<Parent P>(P&& parent) { return take(std::forward<P>(parent), count); } };
+    }
+
+    template <Parent P, typename Pred>
+    auto take_while(P&& parent, Pred pred)
+    {
+        return TakeWhile<P, Pred>{ std::forward<P>(parent), std::move(pred) };
+    }
+
+    template <typename Pred>
+    auto take_while(Pred pred)
+    {
+        return detail::Closure{ [pred = std::move(pred)]<Parent P>(P&& parent) mutable {
+            return take_while(std::forward<P>(parent), std::move(pred));
+        } };
+    }
+
+    template <Parent P, typename Pred>
+    auto skip_while(P&& parent, Pred pred)
+    {
+        return SkipWhile<P, Pred>{ std::forward<P>(parent), std::move(pred) };
+    }
+
+    template <typename Pred>
+    auto skip_while(Pred pred)
+    {
+        return detail::Closure{ [pred = std::move(pred)]<Parent P>(P&& parent) mutable {
+            return skip_while(std::forward<P>(parent), std::move(pred));
+        } };
+    }
+
+    template <Parent P>
+    auto enumerate(P&& parent)
+    {
+        return Enumerate<P>{ std::forward<P>(parent) };
+    }
+
+    inline auto enumerate()
+    {
+        return detail::Closure{ []<Parent P>(P&& parent) { return enumerate(std::forward<P>(parent)); } };
+    }
+
+    template <Parent P, typename S, typename Fn>
+    auto scan(P&& parent, S init, Fn fn)
+    {
+        return Scan<P, S, Fn>{ std::forward<P>(parent), std::move(init), std::move(fn) };
+    }
+
+    template <typename S, typename Fn>
+    auto scan(S init, Fn fn)
+    {
+        return detail::Closure{ [init = std::move(init), fn = std::move(fn)]<Parent P>(P&& parent) mutable {
+            return scan(std::forward<P>(parent), std::move(init), std::move(fn));
+        } };
+    }
+
+    template <Parent P, typename Fn>
+    auto inspect(P&& parent, Fn fn)
+    {
+        return Inspect<P, Fn>{ std::forward<P>(parent), std::move(fn) };
+    }
+
+    template <typename Fn>
+    auto inspect(Fn fn)
+    {
+        return detail::Closure{ [fn = std::move(fn)]<Parent P>(P&& parent) mutable {
+            return inspect(std::forward<P>(parent), std::move(fn));
+        } };
+    }
+
+    template <Parent P, std::uniform_random_bit_generator G>
+    auto bernoulli(P&& parent, double p, G& rng)
+    {
+        return Bernoulli<P, G>{ std::forward<P>(parent), p, rng };
+    }
+
+    template <std::uniform_random_bit_generator G>
+    auto bernoulli(double p, G& rng)
+    {
+        return detail::Closure{ [p, rng = &rng]<Parent P>(P&& parent) {
+            return bernoulli(std::forward<P>(parent), p, *rng);
+        } };
+    }
+}
+
+#endif /* end of include guard: OPT_ITER_ADAPT_HPP */
@@ -0,0 +1,244 @@
+#ifndef OPT_ITER_ALGORITHM_HPP
+#define OPT_ITER_ALGORITHM_HPP
+
+#include "adapt.hpp"
+#include "opt_iter.hpp"
+
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace opt_iter
+{
+    namespace detail
+    {
+        /**
+         * @brief The number of values the iterable of a range yields from the beginning (see
+         * `traits::HasStaticSize`).
+         *
+         * It's only an upper bound of the number of values left in the range since the iterable may have been
+         * partially iterated, so the ranges themselves are not sized.
+         */
+        template <typename Rng>
+        struct StaticSize
+        {
+        };
+
+        template <traits::HasNextLike T, OptIterRet R, bool OwnStorage, Advance A>
+            requires traits::HasStaticSize<T>
+        struct StaticSize<Range<T, R, OwnStorage, A>> : T::static_size
+        {
+            static constexpr bool owned = false;
+        };
+
+        template <traits::HasNextLike T, OptIterRet R, Advance A>
+            requires traits::HasStaticSize<T>
+        struct StaticSize<OwnedRange<T, R, A>> : T::static_size
+        {
+            static constexpr bool owned = true;
+        };
+
+        template <typename Rng>
+        concept StaticBounded = requires { StaticSize<std::remove_cvref_t<Rng>>::value; };
+
+        template <typename Rng>
+        constexpr std::size_t static_size_v = StaticSize<std::remove_cvref_t<Rng>>::value;
+
+        // above this size the terminal operations use a loop with a constant trip count instead
+        inline constexpr std::size_t unroll_limit = 64;
+
+        /**
+         * @brief Call `fn` with each of the first `N` values of the iterator, stopping early at the end.
+         */
+        template <std::size_t N, typename It, typename End, typename Fn>
+        void unrolled(It& it, const End& end, Fn& fn)
+        {
+            if constexpr (N <= unroll_limit) {
+                auto step = [&] {
+                    if (it == end) {
+                        return false;
+                    }
+                    std::invoke(fn, *it);
+                    ++it;
+                    return true;
+                };
+                [&]<std::size_t... I>(std::index_sequence<I...>) {
+                    static_cast<void>(((static_cast<void>(I), step()) and ...));
+                }(std::make_index_sequence<N>{});
+            } else {
+                for (auto i = std::size_t{ 0 }; i < N and it != end; ++i, ++it) {
+                    std::invoke(fn, *it);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Checks if a range yields exactly the number of values known at compile time.
+     *
+     * Only an `OwnedRange` of an iterable with `static_size` (see `traits::HasStaticSize`) passed as an rvalue
+     * qualifies, i.e. a range that is freshly made (e.g. by `make_owned()`) and not iterated before.
+     */
+    template <typename Rng>
+    concept StaticSizedRange = std::ranges::input_range<Rng> and detail::StaticBounded<Rng>
+                           and (not std::is_lvalue_reference_v<Rng>)
+                           and detail::StaticSize<std::remove_cvref_t<Rng>>::owned;
+
+    /**
+     * @brief Call `fn` for each value of the range.
+     *
+     * If the iterable of the range has its size known at compile time, the iteration is unrolled up to that
+     * size. The end of the range is still checked so the range may have been partially iterated.
+     *
+     * @param range The range to iterate.
+     * @param fn The function to be called with each value.
+     */
+    template <std::ranges::input_range Rng, typename Fn>
+        requires std::invocable<Fn&, std::ranges::range_reference_t<Rng>>
+    void for_each(Rng&& range, Fn fn)
+    {
+        if constexpr (detail::StaticBounded<Rng>) {
+            auto it  = std::ranges::begin(range);
+            auto end = std::ranges::end(range);
+            detail::unrolled<detail::static_size_v<Rng>>(it, end, fn);
+        } else {
+            for (auto&& value : range) {
+                std::invoke(fn, std::forward<decltype(value)>(value));
+            }
+        }
+    }
+
+    /**
+     * @brief Left fold the values of the range: `fn(...fn(fn(init, v0), v1)..., vn)`.
+     *
+     * Unrolled the same way as `for_each()` if the iterable of the range has its size known at compile time.
+     *
+     * @param range The range to fold.
+     * @param init The initial value.
+     * @param fn The binary function that combines the accumulated value with the next value.
+     */
+    template <std::ranges::input_range Rng, std::movable Acc, typename Fn>
+        requires std::is_assignable_v<Acc&, std::invoke_result_t<Fn&, Acc, std::ranges::range_reference_t<Rng>>>
+    Acc fold(Rng&& range, Acc init, Fn fn)
+    {
+        auto combine = [&](auto&& value) {
+            init = std::invoke(fn, std::move(init), std::forward<decltype(value)>(value));
+        };
+        for_each(std::forward<Rng>(range), combine);
+        return init;
+    }
+
+    /**
+     * @brief Collect the values of a range with size known at compile time into `std::array`.
+     *
+     * The range must be freshly made and passed as an rvalue (see `StaticSizedRange`), the values are taken in
+     * order without checking for the end of the range.
+     *
+     * @param range The range to collect.
+     */
+    template <StaticSizedRange Rng>
+    auto collect_array(Rng&& range)
+    {
+        using Value = std::ranges::range_value_t<Rng>;
+
+        auto it   = std::ranges::begin(range);
+        auto take = [&](std::size_t) {
+            assert(it != std::ranges::end(range));
+            Value value = *it;
+            ++it;
+            return value;
+        };
+
+        // braced initialization guarantees the left to right evaluation order
+        return [&]<std::size_t... I>(std::index_sequence<I...>) {
+            return std::array<Value, sizeof...(I)>{ take(I)... };
+        }(std::make_index_sequence<detail::static_size_v<Rng>>{});
+    }
+
+    /**
+     * @brief Uniformly sample `k` values from an `OptIter` using reservoir sampling (Algorithm L).
+     *
+     * The number of values to skip between replacements of the reservoir is drawn directly, so the
+     * random number generator is only used `O(k log(n / k))` times. The skipped values are dropped using
+     * the `OptIter`'s `skip()` if it has one (see `traits::HasSkip`), without generating them.
+     *
+     * @param iter The `OptIter` to sample from, it's exhausted afterwards.
+     * @param k The number of values to sample.
+     * @param rng The random number generator.
+     *
+     * @return The sampled values in unspecified order, less than `k` values if the `OptIter` is shorter.
+     */
+    template <typename T, std::uniform_random_bit_generator G>
+        requires adapt::Parent<T> and (not std::ranges::input_range<T>)
+    auto sample(T& iter, std::size_t k, G& rng)
+    {
+        using Opt = adapt::detail::Opt<T&>;
+        using Ret = adapt::detail::Ret<T&>;
+
+        auto reservoir = std::vector<Ret>{};
+        reservoir.reserve(k);
+
+        while (reservoir.size() < k) {
+            auto value = adapt::detail::pull<T&>(iter);
+            if (not traits::OptTrait<Opt>::has_value(value)) {
+                return reservoir;
+            }
+            reservoir.push_back(std::move(traits::OptTrait<Opt>::get(value)));
+        }
+        if (k == 0) {
+            return reservoir;
+        }
+
+        auto uniform = std::uniform_real_distribution<double>{ std::nextafter(0.0, 1.0), 1.0 };
+        auto index   = std::uniform_int_distribution<std::size_t>{ 0, k - 1 };
+        auto w       = std::exp(std::log(uniform(rng)) / static_cast<double>(k));
+
+        while (true) {
+            auto gap = adapt::detail::geometric_gap(rng, std::log1p(-w));
+            if (adapt::detail::skip<T&>(iter, gap) < gap) {
+                return reservoir;
+            }
+
+            auto value = adapt::detail::pull<T&>(iter);
+            if (not traits::OptTrait<Opt>::has_value(value)) {
+                return reservoir;
+            }
+
+            reservoir[index(rng)]  = std::move(traits::OptTrait<Opt>::get(value));
+            w                     *= std::exp(std::log(uniform(rng)) / static_cast<double>(k));
+        }
+    }
+
+    /**
+     * @brief Uniformly sample `k` values from an input range using reservoir sampling (Algorithm L).
+     *
+     * Every value of the range is visited, pass the `OptIter` itself (e.g. `range.underlying()`) to skip
+     * the values without generating them.
+     */
+    template <std::ranges::input_range Rng, std::uniform_random_bit_generator G>
+    auto sample(Rng&& range, std::size_t k, G& rng)
+    {
+        auto iter = std::ranges::begin(range);
+        auto end  = std::ranges::end(range);
+        auto next = [&] {
+            auto value = std::optional<std::ranges::range_value_t<Rng>>{};
+            if (iter != end) {
+                value.emplace(*iter);
+                ++iter;
+            }
+            return value;
+        };
+        return sample(next, k, rng);
+    }
+}
+
+#endif /* end of include guard: OPT_ITER_ALGORITHM_HPP */
@@ -0,0 +1,208 @@
+#ifndef OPT_ITER_ARENA_HPP
+#define OPT_ITER_ARENA_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace opt_iter
+{
+    /**
+     * @class StringArena
+     *
+     * @brief Monotonic buffer for generators that synthesize text (unescaping, joining fields) and yield
+     * `std::string_view`s into it.
+     *
+     * The strings are written one after another into blocks that are never reallocated, so a yielded view stays
+     * valid until the consumer calls `release()`. `release()` resets the arena in bulk and starts a new epoch;
+     * the blocks are kept and reused, so at steady state nothing is allocated. The arena is usually owned by
+     * the consumer and referenced by the generator, so that the consumer decides when the views are released.
+     *
+     * ```cpp
+     * auto arena = opt_iter::StringArena{};
+     * for (auto batch : opt_iter::chunks(opt_iter::make_owned<Unescaper>(input, &arena), 1024)) {
+     *     write_batch(batch);     // the views in the batch are valid here
+     *     arena.release();        // ...and released in bulk before the next batch
+     * }
+     * ```
+     */
+    class [[nodiscard]] StringArena
+    {
+    public:
+        /**
+         * @class Builder
+         *
+         * @brief Appends characters to a string at the tail of the arena, the string is finished by `finish()`.
+         *
+         * Only one builder may be active at a time and the arena must not be written to in between. If the
+         * current block is full, the partial string is moved to a larger block.
+         */
+        class [[nodiscard]] Builder
+        {
+        public:
+            Builder(Builder&& other) noexcept
+                : m_arena{ std::exchange(other.m_arena, nullptr) }
+                , m_size{ other.m_size }
+            {
+            }
+
+            Builder& operator=(Builder&&) = delete;
+
+            ~Builder()
+            {
+                if (m_arena != nullptr) {
+                    m_arena->m_building = false;
+                }
+            }
+
+            void push_back(char c)
+            {
+                reserve(1);
+                m_arena->m_cursor[m_size++] = c;
+            }
+
+            void append(std::string_view str)
+            {
+                if (str.empty()) {
+                    return;
+                }
+                reserve(str.size());
+                std::memcpy(m_arena->m_cursor + m_size, str.data(), str.size());
+                m_size += str.size();
+            }
+
+            std::size_t size() const { return m_size; }
+
+            /**
+             * @brief Commit the string to the arena, the builder must not be used afterwards.
+             */
+            std::string_view finish()
+            {
+                assert(m_arena != nullptr);
+                auto* arena = std::exchange(m_arena, nullptr);
+                auto  str   = std::string_view{ arena->m_cursor, m_size };
+
+                arena->m_cursor   += m_size;
+                arena->m_building  = false;
+                return str;
+            }
+
+        private:
+            friend StringArena;
+
+            explicit Builder(StringArena* arena)
+                : m_arena{ arena }
+            {
+                assert(not arena->m_building);
+                arena->m_building = true;
+            }
+
+            void reserve(std::size_t n)
+            {
+                assert(m_arena != nullptr);
+                if (static_cast<std::size_t>(m_arena->m_end - m_arena->m_cursor) - m_size < n) {
+                    m_arena->next_block(m_size + n, m_size);
+                }
+            }
+
+            StringArena* m_arena;
+            std::size_t  m_size = 0;
+        };
+
+        /**
+         * @param block_size The size of the first block, the following blocks grow geometrically.
+         */
+        explicit StringArena(std::size_t block_size = 4096)
+            : m_block_size{ std::max(block_size, std::size_t{ 1 }) }
+        {
+        }
+
+        StringArena(StringArena&&)            = delete;
+        StringArena& operator=(StringArena&&) = delete;
+
+        /**
+         * @brief Copy the string into the arena.
+         */
+        std::string_view store(std::string_view str)
+        {
+            auto builder = Builder{ this };
+            builder.append(str);
+            return builder.finish();
+        }
+
+        Builder builder() { return Builder{ this }; }
+
+        /**
+         * @brief Invalidate all the views into the arena and start a new epoch, the blocks are kept for reuse.
+         */
+        void release()
+        {
+            assert(not m_building);
+            m_current = 0;
+            m_cursor  = m_blocks.empty() ? nullptr : m_blocks.front().data.get();
+            m_end     = m_blocks.empty() ? nullptr : m_cursor + m_blocks.front().size;
+            ++m_epoch;
+        }
+
+        /**
+         * @brief The number of `release()` calls, can be used to tag the views to check their validity.
+         */
+        std::size_t epoch() const { return m_epoch; }
+
+        /**
+         * @brief The total size of the blocks allocated by the arena.
+         */
+        std::size_t capacity() const
+        {
+            auto total = std::size_t{ 0 };
+            for (const auto& block : m_blocks) {
+                total += block.size;
+            }
+            return total;
+        }
+
+    private:
+        struct Block
+        {
+            std::unique_ptr<char[]> data;
+            std::size_t             size;
+        };
+
+        // move to the next block that fits at least `needed` bytes and carry over `carry` bytes of the partial
+        // string at the cursor
+        void next_block(std::size_t needed, std::size_t carry)
+        {
+            auto* partial = m_cursor;
+
+            auto next = m_blocks.empty() ? std::size_t{ 0 } : m_current + 1;
+            if (next >= m_blocks.size() or m_blocks[next].size < needed) {
+                auto size = std::max(m_blocks.empty() ? m_block_size : m_blocks[m_current].size * 2, needed);
+                auto pos  = m_blocks.begin() + static_cast<std::ptrdiff_t>(next);
+                m_blocks.insert(pos, Block{ std::make_unique_for_overwrite<char[]>(size), size });
+            }
+
+            m_current = next;
+            m_cursor  = m_blocks[next].data.get();
+            m_end     = m_cursor + m_blocks[next].size;
+
+            if (carry > 0) {
+                std::memcpy(m_cursor, partial, carry);
+            }
+        }
+
+        std::vector<Block> m_blocks;
+        std::size_t        m_block_size;
+        std::size_t        m_current  = 0;
+        char*              m_cursor   = nullptr;
+        char*              m_end      = nullptr;
+        std::size_t        m_epoch    = 0;
+        bool               m_building = false;
+    };
+}
+
+#endif /* end of include guard: OPT_ITER_ARENA_HPP */
@@ -0,0 +1,218 @@
+#ifndef OPT_ITER_CALLBACKS_HPP
+#define OPT_ITER_CALLBACKS_HPP
+
+#include <atomic>
+#include <cassert>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace opt_iter
+{
+    /**
+     * @brief How the producer of `CallbackGen` learns that the consumer is gone.
+     *
+     * - `Poll`: the callback returns `false` and drops the value, the producer stops by checking the result
+     *   or `Sink::cancelled()` (default). Nothing is thrown through the producer, e.g. through the frames of
+     *   a C library that calls the callback.
+     * - `Throw`: the callback throws, unwinding the producer. Only for producers that are exception safe.
+     */
+    enum class Cancel
+    {
+        Poll,
+        Throw,
+    };
+
+    /**
+     * @class CallbackGen
+     *
+     * @brief Turns a push-style producer (one that calls a callback for each value) into an `OptIter`.
+     *
+     * @tparam R The type of the values.
+     * @tparam C How the producer is cancelled, see `Cancel`.
+     *
+     * The producer is run on a helper thread and hands the values over through a bounded buffer, so the
+     * memory stays constant regardless of the number of values: the producer blocks when the buffer is full
+     * and `next()` blocks when it's empty. If the `CallbackGen` is destroyed before the producer finishes,
+     * the producer is cancelled and joined, so a producer that ignores the cancellation delays the
+     * destruction until it finishes. An exception thrown by the producer is rethrown from `next()` after the
+     * values produced before it.
+     */
+    template <std::movable R, Cancel C = Cancel::Poll>
+    class [[nodiscard]] CallbackGen
+    {
+    private:
+        struct Shared;
+
+    public:
+        /**
+         * @brief The callback passed to the producer, blocks while the buffer is full.
+         */
+        class Sink
+        {
+        public:
+            explicit Sink(Shared* shared)
+                : m_shared{ shared }
+            {
+            }
+
+            /**
+             * @return `false` if the consumer is gone and the value is dropped (see `Cancel`).
+             */
+            bool operator()(R value) const { return m_shared->push(std::move(value)); }
+
+            bool cancelled() const { return m_shared->cancelled.load(std::memory_order_relaxed); }
+
+        private:
+            Shared* m_shared;
+        };
+
+        template <std::invocable<Sink> Fn>
+        CallbackGen(Fn producer, std::size_t capacity)
+            : m_shared{ std::make_unique<Shared>(capacity) }
+        {
+            assert(capacity > 0);
+            m_thread = std::thread{ [shared = m_shared.get(), producer = std::move(producer)]() mutable {
+                auto exception = std::exception_ptr{};
+                try {
+                    std::invoke(producer, Sink{ shared });
+                } catch (const Cancelled&) {
+                    // the consumer is gone, nothing to report
+                } catch (...) {
+                    exception = std::current_exception();
+                }
+                shared->finish(exception);
+            } };
+        }
+
+        CallbackGen(CallbackGen&&)            = default;
+        CallbackGen& operator=(CallbackGen&&) = delete;
+
+        ~CallbackGen()
+        {
+            if (m_shared) {
+                m_shared->cancel();
+            }
+            if (m_thread.joinable()) {
+                m_thread.join();
+            }
+        }
+
+        std::optional<R> next() { return m_shared->pop(); }
+
+    private:
+        struct Cancelled
+        {
+        };
+
+        struct Shared
+        {
+            Shared(std::size_t capacity)
+                : ring(capacity)
+            {
+            }
+
+            bool push(R value)
+            {
+                auto lock = std::unique_lock{ mutex };
+                not_full.wait(lock, [&] { return count < ring.size() or cancelled; });
+                if (cancelled) {
+                    if constexpr (C == Cancel::Throw) {
+                        throw Cancelled{};
+                    }
+                    return false;
+                }
+
+                ring[(head + count) % ring.size()].emplace(std::move(value));
+
+                // the consumer only waits when the buffer is empty
+                if (count++ == 0) {
+                    lock.unlock();
+                    not_empty.notify_one();
+                }
+                return true;
+            }
+
+            std::optional<R> pop()
+            {
+                auto lock = std::unique_lock{ mutex };
+                not_empty.wait(lock, [&] { return count > 0 or finished; });
+                if (count == 0) {
+                    if (exception) {
+                        std::rethrow_exception(std::exchange(exception, nullptr));
+                    }
+                    return std::nullopt;
+                }
+
+                auto value = std::exchange(ring[head], std::nullopt);
+                head       = (head + 1) % ring.size();
+
+                // the producer only waits when the buffer is full
+                if (count-- == ring.size()) {
+                    lock.unlock();
+                    not_full.notify_one();
+                }
+                return value;
+            }
+
+            void finish(std::exception_ptr error)
+            {
+                {
+                    auto lock = std::lock_guard{ mutex };
+                    finished  = true;
+                    exception = std::move(error);
+                }
+                not_empty.notify_all();
+            }
+
+            void cancel()
+            {
+                {
+                    auto lock = std::lock_guard{ mutex };
+                    cancelled = true;
+                }
+                not_full.notify_all();
+            }
+
+            std::mutex              mutex;
+            std::condition_variable not_empty;
+            std::condition_variable not_full;
+
+            std::vector<std::optional<R>> ring;
+            std::size_t                   head      = 0;
+            std::size_t                   count     = 0;
+            bool                          finished  = false;
+            std::atomic<bool>             cancelled = false;    // written under the mutex, polled without it
+            std::exception_ptr            exception = nullptr;
+        };
+
+        std::unique_ptr<Shared> m_shared;
+        std::thread             m_thread;
+    };
+
+    /**
+     * @brief Turn a push-style producer into an `OptIter`.
+     *
+     * @tparam R The type of the values.
+     * @tparam C How the producer is cancelled, see `Cancel`.
+     *
+     * @param producer The function that is called with the callback (`CallbackGen<R, C>::Sink`) on a helper
+     * thread and calls it for each value.
+     * @param capacity The number of values that can be buffered before the producer blocks.
+     */
+    template <std::movable R, Cancel C = Cancel::Poll, std::invocable<typename CallbackGen<R, C>::Sink> Fn>
+    CallbackGen<R, C> from_callbacks(Fn producer, std::size_t capacity = 64)
+    {
+        return CallbackGen<R, C>{ std::move(producer), capacity };
+    }
+}
+
+#endif /* end of include guard: OPT_ITER_CALLBACKS_HPP */
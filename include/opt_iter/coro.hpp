@@ -0,0 +1,257 @@
+#ifndef OPT_ITER_CORO_HPP
+#define OPT_ITER_CORO_HPP
+
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace opt_iter
+{
+    namespace detail
+    {
+        /**
+         * @class FramePool
+         *
+         * @brief Thread-local cache of freed coroutine frames, bucketed by size.
+         *
+         * Frames are rounded up to a multiple of `granularity`, frames larger than `max_size` are not cached.
+         * Each bucket keeps at most `max_cached` frames, the rest are returned to the global allocator.
+         *
+         * A frame may be freed after the pool of the thread is destroyed at thread exit (e.g. by a coroutine
+         * held in a static or another thread-local object), the frames then go to the global allocator.
+         */
+        class FramePool
+        {
+        public:
+            static constexpr std::size_t granularity = 64;
+            static constexpr std::size_t max_size    = 4096;
+            static constexpr std::size_t max_cached  = 16;
+
+            FramePool() = default;
+
+            FramePool(const FramePool&)            = delete;
+            FramePool& operator=(const FramePool&) = delete;
+
+            ~FramePool()
+            {
+                for (auto& bucket : m_buckets) {
+                    for (auto* frame : bucket) {
+                        ::operator delete(frame);
+                    }
+                }
+                destroyed() = true;
+            }
+
+            /**
+             * @brief Allocate a frame from the pool of the calling thread.
+             */
+            static void* allocate_local(std::size_t size)
+            {
+                if (destroyed()) {
+                    return ::operator new(size);
+                }
+                return local().allocate(size);
+            }
+
+            /**
+             * @brief Return a frame to the pool of the calling thread, or to the global allocator if it's gone.
+             */
+            static void deallocate_local(void* frame, std::size_t size) noexcept
+            {
+                if (destroyed()) {
+                    ::operator delete(frame);
+                    return;
+                }
+                local().deallocate(frame, size);
+            }
+
+            void* allocate(std::size_t size)
+            {
+                if (size > max_size) {
+                    return ::operator new(size);
+                }
+
+                auto& bucket = m_buckets[bucket_index(size)];
+                if (bucket.empty()) {
+                    return ::operator new(bucket_size(size));
+                }
+
+                auto* frame = bucket.back();
+                bucket.pop_back();
+                return frame;
+            }
+
+            void deallocate(void* frame, std::size_t size) noexcept
+            {
+                if (size > max_size) {
+                    ::operator delete(frame);
+                    return;
+                }
+
+                auto& bucket = m_buckets[bucket_index(size)];
+                if (bucket.size() >= max_cached) {
+                    ::operator delete(frame);
+                    return;
+                }
+
+                // reserved up front so that caching a frame never throws
+                if (bucket.capacity() == 0) {
+                    try {
+                        bucket.reserve(max_cached);
+                    } catch (...) {
+                        ::operator delete(frame);
+                        return;
+                    }
+                }
+                bucket.push_back(frame);
+            }
+
+        private:
+            static constexpr std::size_t bucket_count = max_size / granularity;
+
+            static FramePool& local()
+            {
+                thread_local auto pool = FramePool{};
+                return pool;
+            }
+
+            // trivially destructible, so it's still readable after the pool is destroyed
+            static bool& destroyed()
+            {
+                thread_local auto flag = false;
+                return flag;
+            }
+
+            static std::size_t bucket_index(std::size_t size) { return (size + granularity - 1) / granularity - 1; }
+            static std::size_t bucket_size(std::size_t size) { return (bucket_index(size) + 1) * granularity; }
+
+            std::array<std::vector<void*>, bucket_count> m_buckets;
+        };
+    }
+
+    /**
+     * @class Coro
+     *
+     * @brief Coroutine return type that is an `OptIter` itself.
+     *
+     * @tparam R The type of the yielded values, must be default-initializable.
+     *
+     * `Coro` has `bool next(R& out)` member function, so the range wrappers keep a single `R` in their storage
+     * and `co_yield` assigns the value directly into it; the value is not moved again through an optional or
+     * by dereferencing the iterator. The coroutine frame is allocated from a thread-local pool of freed frames,
+     * so creating coroutines repeatedly in a loop doesn't hit the global allocator at steady state.
+     *
+     * An exception thrown by the coroutine is rethrown from `next()`.
+     *
+     * ```cpp
+     * opt_iter::Coro<int> iota(int limit)
+     * {
+     *     for (auto i = 0; i < limit; ++i) {
+     *         co_yield i;
+     *     }
+     * }
+     *
+     * for (auto v : opt_iter::make_owned<opt_iter::Coro<int>>(iota(10))) { ... }
+     * ```
+     */
+    template <std::default_initializable R>
+    class [[nodiscard]] Coro
+    {
+    public:
+        struct promise_type
+        {
+            Coro get_return_object() { return Coro{ Handle::from_promise(*this) }; }
+
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            std::suspend_always final_suspend() noexcept { return {}; }
+
+            std::suspend_always yield_value(const R& value)
+            {
+                *out = value;
+                return {};
+            }
+
+            std::suspend_always yield_value(R&& value)
+            {
+                *out = std::move(value);
+                return {};
+            }
+
+            void return_void() noexcept { }
+            void unhandled_exception() { exception = std::current_exception(); }
+
+            static void* operator new(std::size_t size) { return detail::FramePool::allocate_local(size); }
+
+            static void operator delete(void* frame, std::size_t size) noexcept
+            {
+                detail::FramePool::deallocate_local(frame, size);
+            }
+
+            R*                 out       = nullptr;
+            std::exception_ptr exception = nullptr;
+        };
+
+        using Handle = std::coroutine_handle<promise_type>;
+
+        Coro(Coro&& other) noexcept
+            : m_handle{ std::exchange(other.m_handle, nullptr) }
+        {
+        }
+
+        Coro& operator=(Coro&& other) noexcept
+        {
+            if (this != &other) {
+                destroy();
+                m_handle = std::exchange(other.m_handle, nullptr);
+            }
+            return *this;
+        }
+
+        ~Coro() { destroy(); }
+
+        /**
+         * @brief Resume the coroutine until the next `co_yield` that assigns to `out`.
+         *
+         * @return `false` if the coroutine has finished.
+         */
+        bool next(R& out)
+        {
+            if (not m_handle or m_handle.done()) {
+                return false;
+            }
+
+            m_handle.promise().out = &out;
+            m_handle.resume();
+
+            if (auto exception = std::exchange(m_handle.promise().exception, nullptr)) {
+                std::rethrow_exception(exception);
+            }
+            return not m_handle.done();
+        }
+
+    private:
+        explicit Coro(Handle handle)
+            : m_handle{ handle }
+        {
+        }
+
+        void destroy()
+        {
+            if (m_handle) {
+                m_handle.destroy();
+                m_handle = nullptr;
+            }
+        }
+
+        Handle m_handle = nullptr;
+    };
+}
+
+#endif /* end of include guard: OPT_ITER_CORO_HPP */
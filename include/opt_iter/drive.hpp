@@ -0,0 +1,326 @@
+#ifndef OPT_ITER_DRIVE_HPP
+#define OPT_ITER_DRIVE_HPP
+
+#include "adapt.hpp"
+#include "traits.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * Push-model sinks for `opt_iter::drive()`.
+ *
+ * A chain is composed at compile time from stages (`map`, `filter`, `take`) and ends with a terminal sink
+ * (`into_vector`, `sum`). The driver calls `next()` in a loop and pushes each value through the chain, there
+ * are no iterators and no storage involved. A sink signals that it doesn't need more values through `done()`
+ * (e.g. `take` after `n` values), which stops the driver before it calls `next()` again.
+ *
+ * ```cpp
+ * namespace sink = opt_iter::sink;
+ *
+ * auto chain  = sink::filter(is_even) | sink::map(negate) | sink::take(10) | sink::into_vector();
+ * auto values = opt_iter::drive(gen, std::move(chain));
+ * ```
+ */
+namespace opt_iter::sink
+{
+    /**
+     * @class Chain
+     *
+     * @brief The stages of a sink chain, composed with `operator|`. The last stage must be a terminal sink.
+     *
+     * @tparam Stages The descriptors of the stages, bound to the type of the values once driven.
+     */
+    template <typename... Stages>
+    class [[nodiscard]] Chain
+    {
+    public:
+        explicit Chain(Stages... stages)
+            : m_stages{ std::move(stages)... }
+        {
+        }
+
+        template <typename... Others>
+        friend Chain<Stages..., Others...> operator|(Chain lhs, Chain<Others...> rhs)
+        {
+            return std::apply(
+                [&](auto&&... all) { return Chain<Stages..., Others...>{ std::move(all)... }; },
+                std::tuple_cat(std::move(lhs.m_stages), std::move(rhs).stages())
+            );
+        }
+
+        std::tuple<Stages...>&& stages() && { return std::move(m_stages); }
+
+        /**
+         * @brief Create the sink for values of type `In`.
+         */
+        template <typename In>
+        auto bind() &&
+        {
+            return std::move(*this).template bind_from<In, 0>();
+        }
+
+    private:
+        template <typename In, std::size_t I>
+        auto bind_from()
+        {
+            auto&& stage = std::get<I>(std::move(m_stages));
+            if constexpr (I + 1 == sizeof...(Stages)) {
+                return std::move(stage).template bind<In>();
+            } else {
+                using Out = std::remove_cvref_t<decltype(stage)>::template Out<In>;
+                return std::move(stage).template bind<In>(bind_from<Out, I + 1>());
+            }
+        }
+
+        std::tuple<Stages...> m_stages;
+    };
+
+    namespace detail
+    {
+        template <typename Fn, typename Down>
+        struct MapSink
+        {
+            bool done() const { return down.done(); }
+            auto result() { return down.result(); }
+
+            template <typename V>
+            void push(V&& value)
+            {
+                down.push(std::invoke(fn, std::forward<V>(value)));
+            }
+
+            Fn   fn;
+            Down down;
+        };
+
+        template <typename Pred, typename Down>
+        struct FilterSink
+        {
+            bool done() const { return down.done(); }
+            auto result() { return down.result(); }
+
+            template <typename V>
+            void push(V&& value)
+            {
+                if (std::invoke(pred, std::as_const(value))) {
+                    down.push(std::forward<V>(value));
+                }
+            }
+
+            Pred pred;
+            Down down;
+        };
+
+        template <typename Down>
+        struct TakeSink
+        {
+            bool done() const { return remaining == 0 or down.done(); }
+            auto result() { return down.result(); }
+
+            template <typename V>
+            void push(V&& value)
+            {
+                --remaining;
+                down.push(std::forward<V>(value));
+            }
+
+            std::size_t remaining;
+            Down        down;
+        };
+
+        template <typename T>
+        struct IntoVectorSink
+        {
+            bool           done() const { return false; }
+            std::vector<T> result() { return std::move(values); }
+
+            template <typename V>
+            void push(V&& value)
+            {
+                values.emplace_back(std::forward<V>(value));
+            }
+
+            std::vector<T> values;
+        };
+
+        template <typename T>
+        struct SumSink
+        {
+            bool done() const { return false; }
+            T    result() { return std::move(total); }
+
+            template <typename V>
+            void push(V&& value)
+            {
+                total += std::forward<V>(value);
+            }
+
+            T total;
+        };
+
+        template <typename Fn>
+        struct Map
+        {
+            template <typename In>
+            using Out = std::invoke_result_t<Fn&, In>;
+
+            template <typename In, typename Down>
+            MapSink<Fn, Down> bind(Down down) &&
+            {
+                return { std::move(fn), std::move(down) };
+            }
+
+            Fn fn;
+        };
+
+        template <typename Pred>
+        struct Filter
+        {
+            template <typename In>
+            using Out = In;
+
+            template <typename In, typename Down>
+            FilterSink<Pred, Down> bind(Down down) &&
+            {
+                return { std::move(pred), std::move(down) };
+            }
+
+            Pred pred;
+        };
+
+        struct Take
+        {
+            template <typename In>
+            using Out = In;
+
+            template <typename In, typename Down>
+            TakeSink<Down> bind(Down down) &&
+            {
+                return { count, std::move(down) };
+            }
+
+            std::size_t count;
+        };
+
+        struct IntoVector
+        {
+            template <typename In>
+            IntoVectorSink<std::remove_cvref_t<In>> bind() &&
+            {
+                auto sink = IntoVectorSink<std::remove_cvref_t<In>>{};
+                sink.values.reserve(reserve);
+                return sink;
+            }
+
+            std::size_t reserve;
+        };
+
+        template <typename T>
+        struct Sum
+        {
+            template <typename In>
+            auto bind() &&
+            {
+                if constexpr (std::same_as<T, void>) {
+                    return SumSink<std::remove_cvref_t<In>>{ {} };
+                } else {
+                    return SumSink<T>{ std::move(init) };
+                }
+            }
+
+            [[no_unique_address]] std::conditional_t<std::same_as<T, void>, std::tuple<>, T> init;
+        };
+    }
+
+    template <typename Fn>
+    Chain<detail::Map<Fn>> map(Fn fn)
+    {
+        return Chain{ detail::Map<Fn>{ std::move(fn) } };
+    }
+
+    template <typename Pred>
+    Chain<detail::Filter<Pred>> filter(Pred pred)
+    {
+        return Chain{ detail::Filter<Pred>{ std::move(pred) } };
+    }
+
+    inline Chain<detail::Take> take(std::size_t count)
+    {
+        return Chain{ detail::Take{ count } };
+    }
+
+    /**
+     * @brief Terminal sink that collects the values into `std::vector`.
+     *
+     * @param reserve The number of values to reserve up front.
+     */
+    inline Chain<detail::IntoVector> into_vector(std::size_t reserve = 0)
+    {
+        return Chain{ detail::IntoVector{ reserve } };
+    }
+
+    /**
+     * @brief Terminal sink that sums the values, starting from a value-initialized value of their type.
+     */
+    inline Chain<detail::Sum<void>> sum()
+    {
+        return Chain{ detail::Sum<void>{} };
+    }
+
+    /**
+     * @brief Terminal sink that sums the values, starting from `init`.
+     */
+    template <typename T>
+    Chain<detail::Sum<T>> sum(T init)
+    {
+        return Chain{ detail::Sum<T>{ std::move(init) } };
+    }
+}
+
+namespace opt_iter
+{
+    /**
+     * @brief Call `next()` of the `OptIter` in a loop and push each value through a sink chain.
+     *
+     * @param iter The `OptIter` to drive.
+     * @param chain The sink chain, see `opt_iter::sink`.
+     *
+     * @return The result of the terminal sink.
+     */
+    template <typename T, typename... Stages>
+        requires adapt::Parent<T> or traits::HasNextInto<std::remove_cvref_t<T>>
+    auto drive(T&& iter, sink::Chain<Stages...> chain)
+    {
+        using Inner = std::remove_cvref_t<T>;
+        using Ret   = traits::OptIterTrait<Inner>::Ret;
+        using In    = std::conditional_t<traits::HasNextInto<Inner>, Ret&, Ret&&>;
+
+        auto sink = std::move(chain).template bind<In>();
+
+        if constexpr (traits::HasNextInto<Inner>) {
+            auto value = Ret{};
+            while (not sink.done() and iter.next(value)) {
+                sink.push(value);
+            }
+        } else {
+            using Opt = traits::OptIterTrait<Inner>::Opt;
+            while (not sink.done()) {
+                auto value = adapt::detail::pull<Inner&>(iter);
+                if (not traits::OptTrait<Opt>::has_value(value)) {
+                    break;
+                }
+                sink.push(std::move(traits::OptTrait<Opt>::get(value)));
+            }
+        }
+
+        return sink.result();
+    }
+}
+
+#endif /* end of include guard: OPT_ITER_DRIVE_HPP */
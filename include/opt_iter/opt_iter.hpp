@@ -3,11 +3,15 @@
 
 #include "traits.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <concepts>
+#include <cstddef>
+#include <functional>
 #include <iterator>
 #include <memory>
 #include <optional>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 
@@ -28,7 +32,76 @@ namespace opt_iter
      * @tparam R The return type of the iterable (unwrapped).
      */
     template <typename T>
-    concept OptIter = traits::HasNext<T> or traits::HasCallOp<T>;
+    concept OptIter = traits::HasNextLike<T> or traits::HasCallOp<T> or traits::HasTryNext<T>;
+
+    namespace detail
+    {
+        /**
+         * @brief Fill the storage with the next value of the iterable.
+         *
+         * Iterables with `bool next(R& out)` refill the value kept in the storage in place, the others have
+         * their returned optional-like value assigned to the storage.
+         */
+        template <traits::HasNextLike T>
+        void fill(T& t, typename traits::OptIterTrait<T>::Opt& storage)
+        {
+            if constexpr (traits::HasNextInto<T>) {
+                storage.engaged = t.next(storage.value);
+            } else {
+                storage = t.next();
+            }
+        }
+
+        // copying an empty storage is skipped, e.g. RefillOpt keeps its value alive even when empty
+        template <traits::OptLike Opt>
+        Opt copy_storage(const Opt& storage)
+        {
+            if (traits::OptTrait<Opt>::has_value(storage)) {
+                return storage;
+            }
+            return Opt{};
+        }
+
+        template <traits::OptLike Opt>
+        void restore_storage(Opt& storage, const Opt& saved)
+        {
+            if (traits::OptTrait<Opt>::has_value(saved)) {
+                storage = saved;
+            } else {
+                traits::OptTrait<Opt>::reset(storage);
+            }
+        }
+    }
+
+    /**
+     * @class Checkpoint
+     *
+     * @brief A snapshot of the state of a range: the iterable and the value in the storage.
+     *
+     * @tparam T The type of the iterable.
+     * @tparam Opt The type of the storage.
+     */
+    template <typename T, traits::OptLike Opt>
+    struct [[nodiscard]] Checkpoint
+    {
+        T   t;
+        Opt store = {};
+    };
+
+    /**
+     * @brief When the iterator calls the iterable's `next()`.
+     *
+     * - `Eager`: `begin()` and `operator++` call `next()` immediately (default).
+     * - `Lazy`: `begin()` and `operator++` only mark the storage as stale, `next()` is called on the
+     *   following dereference or comparison with the sentinel. This avoids generating one value past the
+     *   point where the consumer stops (e.g. `std::views::take`). Incrementing a stale iterator calls `next()`
+     *   to consume the skipped value.
+     */
+    enum class Advance
+    {
+        Eager,
+        Lazy,
+    };
 
     /**
      * @class Sentinel
@@ -46,11 +119,19 @@ namespace opt_iter
      *
      * @tparam T The type of the iterable.
      * @tparam R The return type of the iterable (unwrapped).
+     * @tparam A When `next()` is called, see `Advance`.
+     *
+     * The storage has the same type as the optional-like type returned by `T::next()`. For iterables that
+     * refill the value in place (`bool next(R& out)`), dereferencing yields a reference to the value in the
+     * storage instead of moving it out so the value can be reused by the next refill.
      */
-    template <traits::HasNext T, OptIterRet R>
+    template <traits::HasNextLike T, OptIterRet R, Advance A = Advance::Eager>
     class [[nodiscard]] Iterator
     {
     public:
+        using Opt = traits::OptIterTrait<T>::Opt;
+        using Ref = std::conditional_t<traits::HasNextInto<T>, R&, R>;
+
         using value_type        = R;
         using difference_type   = std::ptrdiff_t;
         using iterator_category = std::input_iterator_tag;
@@ -62,6 +143,7 @@ namespace opt_iter
         Iterator(Iterator&& other) noexcept
             : m_t{ std::exchange(other.m_t, nullptr) }
             , m_storage{ std::exchange(other.m_storage, nullptr) }
+            , m_stale{ std::exchange(other.m_stale, false) }
         {
         }
 
@@ -69,24 +151,43 @@ namespace opt_iter
         {
             m_t       = std::exchange(other.m_t, nullptr);
             m_storage = std::exchange(other.m_storage, nullptr);
+            m_stale   = std::exchange(other.m_stale, false);
             return *this;
         }
 
-        Iterator(T* t, std::optional<R>* storage)
+        /**
+         * @brief Construct an iterator, a lazy iterator with empty storage is considered stale.
+         */
+        Iterator(T* t, Opt* storage)
             : m_t{ t }
             , m_storage{ storage }
+            , m_stale{ A == Advance::Lazy and not traits::OptTrait<Opt>::has_value(*storage) }
         {
         }
 
-        [[nodiscard]] R operator*() const
+        [[nodiscard]] Ref operator*() const
         {
-            assert(*m_storage != std::nullopt);
-            return std::move(*m_storage).value();
+            refresh();
+            assert(traits::OptTrait<Opt>::has_value(*m_storage));
+            if constexpr (std::is_reference_v<Ref>) {
+                return traits::OptTrait<Opt>::get(*m_storage);
+            } else {
+                return std::move(traits::OptTrait<Opt>::get(*m_storage));
+            }
         }
 
         Iterator& operator++()
         {
-            *m_storage = std::move(m_t->next());
+            if constexpr (A == Advance::Lazy) {
+                // the value pending from the previous increment is consumed without being looked at
+                if (m_stale) {
+                    detail::fill(*m_t, *m_storage);
+                }
+                traits::OptTrait<Opt>::reset(*m_storage);
+                m_stale = true;
+            } else {
+                detail::fill(*m_t, *m_storage);
+            }
             return *this;
         }
 
@@ -99,14 +200,30 @@ namespace opt_iter
 
         friend bool operator==(const Iterator& it, const Sentinel&)
         {
-            return !it.m_storage || *it.m_storage == std::nullopt;
+            if (!it.m_storage) {
+                return true;
+            }
+            it.refresh();
+            return not traits::OptTrait<Opt>::has_value(*it.m_storage);
         }
 
         friend bool operator==(const Sentinel&, const Iterator& it) { return it == Sentinel{}; }
 
     private:
-        T*                m_t       = nullptr;
-        std::optional<R>* m_storage = nullptr;
+        // only ever true for lazy iterator
+        void refresh() const
+        {
+            if constexpr (A == Advance::Lazy) {
+                if (m_stale) {
+                    detail::fill(*m_t, *m_storage);
+                    m_stale = false;
+                }
+            }
+        }
+
+        T*           m_t       = nullptr;
+        Opt*         m_storage = nullptr;
+        mutable bool m_stale   = false;
     };
 
     /**
@@ -121,7 +238,9 @@ namespace opt_iter
         requires std::same_as<typename traits::OptIterTrait<F>::Ret, R>
     struct [[nodiscard]] FnWrapper
     {
-        std::optional<R> next()
+        using Opt = traits::OptIterTrait<F>::Opt;
+
+        Opt next()
         {
             assert(fn != nullptr);
             return fn->operator()();
@@ -130,6 +249,264 @@ namespace opt_iter
         F* fn = nullptr;
     };
 
+    /**
+     * @class TryWrapper
+     *
+     * @brief Wraps an iterable whose `next()` returns `std::expected<std::optional<R>, E>`.
+     *
+     * @tparam T The type of the iterable.
+     * @tparam R The return type of the iterable (unwrapped).
+     * @tparam E The error type of the iterable.
+     *
+     * The first error reported by the iterable is stored and ends the iteration. Once an error is stored,
+     * `next()` returns an empty optional without calling the iterable until the error is cleared.
+     */
+    template <traits::HasTryNext T, OptIterRet R, typename E>
+        requires std::same_as<typename traits::OptIterTrait<T>::Ret, R>
+    struct [[nodiscard]] TryWrapper
+    {
+        using Opt = traits::OptIterTrait<T>::Opt;
+
+        Opt next()
+        {
+            assert(t != nullptr);
+            if (error.has_value()) {
+                return Opt{};
+            }
+
+            auto result = t->next();
+            if (not result.has_value()) {
+                error.emplace(std::move(result).error());
+                return Opt{};
+            }
+            return std::move(result).value();
+        }
+
+        T*               t     = nullptr;
+        std::optional<E> error = std::nullopt;
+    };
+
+    template <traits::HasNextLike T, OptIterRet R, Advance A>
+    class OwnedRange;
+
+    template <traits::HasCallOp Fn, OptIterRet R, Advance A>
+        requires std::same_as<typename traits::OptIterTrait<Fn>::Ret, R>
+    class OwnedRangeFn;
+
+    /**
+     * @class SpanWrapper
+     *
+     * @brief Wraps an iterable that yields `std::span<const R>` so that it iterates the values one by one.
+     *
+     * @tparam T The type of the iterable, can be an lvalue reference to not own the iterable.
+     *
+     * The wrapper keeps a cursor into the last span returned by the iterable and only calls the iterable's
+     * `next()` once the span is exhausted. The span returned by the iterable must stay valid until the next
+     * call to its `next()`. Empty spans are skipped.
+     *
+     * The span points into the iterable it was returned by, so a copy of the wrapper (e.g. by `fork()`) keeps
+     * its own copy of the values left in the current span instead of referring to the span.
+     */
+    template <typename T>
+        requires traits::HasSpanNext<std::remove_cvref_t<T>>
+    class [[nodiscard]] SpanWrapper
+    {
+    public:
+        using Inner = std::remove_cvref_t<T>;
+        using Span  = traits::OptIterTrait<Inner>::Ret;
+        using Ret   = traits::SpanTrait<Span>::Type;
+
+        template <typename... Args>
+            requires std::constructible_from<T, Args...>
+        SpanWrapper(std::in_place_t, Args&&... args)
+            : m_t{ std::forward<Args>(args)... }
+        {
+        }
+
+        SpanWrapper(const SpanWrapper& other)
+            requires std::copy_constructible<T> and std::copyable<Ret> and std::default_initializable<Ret>
+            : m_t{ other.m_t }
+            , m_pending{ copy_pending(other) }
+            , m_first{ m_pending.get() }
+            , m_last{ m_pending.get() + (other.m_last - other.m_first) }
+        {
+        }
+
+        SpanWrapper& operator=(const SpanWrapper& other)
+            requires std::is_copy_assignable_v<T> and std::copyable<Ret> and std::default_initializable<Ret>
+        {
+            if (this != &other) {
+                auto pending = copy_pending(other);
+                m_t          = other.m_t;
+                m_first      = pending.get();
+                m_last       = pending.get() + (other.m_last - other.m_first);
+                m_pending    = std::move(pending);
+            }
+            return *this;
+        }
+
+        // the pending values are moved along with their buffer, so the cursors stay valid
+        SpanWrapper(SpanWrapper&&)            = default;
+        SpanWrapper& operator=(SpanWrapper&&) = default;
+
+        std::optional<Ret> next()
+        {
+            using Opt = traits::OptIterTrait<Inner>::Opt;
+
+            while (m_first == m_last) {
+                auto span = m_t.next();
+                if (not traits::OptTrait<Opt>::has_value(span)) {
+                    return std::nullopt;
+                }
+
+                auto& run = traits::OptTrait<Opt>::get(span);
+                m_first   = run.data();
+                m_last    = run.data() + run.size();
+            }
+            return *m_first++;
+        }
+
+        Inner&       underlying() { return m_t; }
+        const Inner& underlying() const { return m_t; }
+
+        /**
+         * @brief Drop the remaining values of the current span.
+         */
+        void clear() { m_first = m_last = nullptr; }
+
+        void reset()
+            requires traits::HasReset<Inner>
+        {
+            m_t.reset();
+            clear();
+        }
+
+    private:
+        using Ptr = decltype(std::declval<Span&>().data());
+
+        // an array rather than std::vector, std::vector<bool> doesn't store the values contiguously
+        static std::unique_ptr<Ret[]> copy_pending(const SpanWrapper& other)
+        {
+            if (other.m_first == other.m_last) {
+                return nullptr;
+            }
+            auto size    = static_cast<std::size_t>(other.m_last - other.m_first);
+            auto pending = std::make_unique_for_overwrite<Ret[]>(size);
+            std::copy(other.m_first, other.m_last, pending.get());
+            return pending;
+        }
+
+        T                      m_t;
+        std::unique_ptr<Ret[]> m_pending = nullptr;    // the values left in the span of the copied wrapper
+        Ptr                    m_first   = nullptr;
+        Ptr                    m_last    = nullptr;
+    };
+
+    /**
+     * @class RevWrapper
+     *
+     * @brief Wraps a double-ended iterable so that it iterates from the back.
+     *
+     * @tparam T The type of the iterable, can be an lvalue reference to not own the iterable.
+     *
+     * `next()` and `next_back()` of the iterable are swapped. A value already taken from the front of the
+     * iterable (e.g. by the storage of a range) can be handed over using `set_front()`, it will be yielded
+     * last.
+     */
+    template <typename T>
+        requires traits::HasNextBack<std::remove_cvref_t<T>>
+    class [[nodiscard]] RevWrapper
+    {
+    public:
+        using Inner = std::remove_cvref_t<T>;
+        using Opt   = traits::OptIterTrait<Inner>::Opt;
+
+        template <typename... Args>
+            requires std::constructible_from<T, Args...>
+        RevWrapper(std::in_place_t, Args&&... args)
+            : m_t{ std::forward<Args>(args)... }
+        {
+        }
+
+        Opt next()
+        {
+            auto value = m_t.next_back();
+            if (not traits::OptTrait<Opt>::has_value(value)) {
+                return std::exchange(m_front, Opt{});
+            }
+            return value;
+        }
+
+        Opt next_back()
+        {
+            if (traits::OptTrait<Opt>::has_value(m_front)) {
+                return std::exchange(m_front, Opt{});
+            }
+            return m_t.next();
+        }
+
+        void set_front(Opt front) { m_front = std::move(front); }
+
+        Inner&       underlying() { return m_t; }
+        const Inner& underlying() const { return m_t; }
+
+    private:
+        T   m_t;
+        Opt m_front = {};
+    };
+
+    /**
+     * @class EndsWrapper
+     *
+     * @brief Wraps a double-ended iterable so that it iterates from both ends until they meet.
+     *
+     * @tparam T The type of the iterable, can be an lvalue reference to not own the iterable.
+     *
+     * Each value is a pair of the value from the front and the value from the back. The value from the back
+     * is empty if there is only one value left in the middle. A value already taken from the front of the
+     * iterable can be handed over using `set_front()`, it will be yielded as the first front value.
+     */
+    template <typename T>
+        requires traits::HasNextBack<std::remove_cvref_t<T>>
+    class [[nodiscard]] EndsWrapper
+    {
+    public:
+        using Inner = std::remove_cvref_t<T>;
+        using Opt   = traits::OptIterTrait<Inner>::Opt;
+        using Value = traits::OptIterTrait<Inner>::Ret;
+        using Ret   = std::pair<Value, std::optional<Value>>;
+
+        template <typename... Args>
+            requires std::constructible_from<T, Args...>
+        EndsWrapper(std::in_place_t, Args&&... args)
+            : m_t{ std::forward<Args>(args)... }
+        {
+        }
+
+        std::optional<Ret> next()
+        {
+            auto front = traits::OptTrait<Opt>::has_value(m_front) ? std::exchange(m_front, Opt{}) : m_t.next();
+            if (not traits::OptTrait<Opt>::has_value(front)) {
+                return std::nullopt;
+            }
+
+            auto back = m_t.next_back();
+            if (not traits::OptTrait<Opt>::has_value(back)) {
+                return Ret{ std::move(traits::OptTrait<Opt>::get(front)), std::nullopt };
+            }
+            return Ret{ std::move(traits::OptTrait<Opt>::get(front)), std::move(traits::OptTrait<Opt>::get(back)) };
+        }
+
+        void set_front(Opt front) { m_front = std::move(front); }
+
+        Inner&       underlying() { return m_t; }
+        const Inner& underlying() const { return m_t; }
+
+    private:
+        T   m_t;
+        Opt m_front = {};
+    };
+
     /**
      * @class Range
      *
@@ -138,25 +515,27 @@ namespace opt_iter
      * @tparam T The type of the iterable.
      * @tparam R The return type of the iterable (unwrapped).
      * @tparam OwnStorage Whether the range should create the storage of the optional by its own.
+     * @tparam A When the iterator calls `next()`, see `Advance`.
      */
-    template <traits::HasNext T, OptIterRet R, bool OwnStorage>
+    template <traits::HasNextLike T, OptIterRet R, bool OwnStorage, Advance A = Advance::Eager>
     class [[nodiscard]] Range
     {
     public:
         using Ret   = R;
-        using Store = std::conditional_t<OwnStorage, std::unique_ptr<std::optional<R>>, std::optional<R>*>;
+        using Opt   = traits::OptIterTrait<T>::Opt;
+        using Store = std::conditional_t<OwnStorage, std::unique_ptr<Opt>, Opt*>;
 
-        Range(std::optional<R>& storage, T& t)
-            requires std::same_as<Store, std::optional<R>*>
+        Range(Opt& storage, T& t)
+            requires std::same_as<Store, Opt*>
             : m_t{ &t }
             , m_storage{ &storage }
         {
         }
 
         Range(T& t)
-            requires std::same_as<Store, std::unique_ptr<std::optional<R>>>
+            requires std::same_as<Store, std::unique_ptr<Opt>>
             : m_t{ &t }
-            , m_storage{ std::make_unique<std::optional<R>>() }
+            , m_storage{ std::make_unique<Opt>() }
         {
         }
 
@@ -169,16 +548,87 @@ namespace opt_iter
         void clear()
         {
             assert(m_storage != nullptr);
-            *m_storage = std::nullopt;
+            traits::OptTrait<Opt>::reset(*m_storage);
         }
 
-        Iterator<T, R> begin()
+        /**
+         * @brief Reset the underlying iterable and clear the storage at once.
+         */
+        void reset()
+            requires traits::HasReset<T>
+        {
+            underlying().reset();
+            clear();
+        }
+
+        /**
+         * @brief Capture the state of the iterable and the storage.
+         */
+        Checkpoint<T, Opt> checkpoint() const
+            requires std::copyable<T>
+        {
+            assert(m_t != nullptr and m_storage != nullptr);
+            return { *m_t, detail::copy_storage(*m_storage) };
+        }
+
+        /**
+         * @brief Restore the state of the iterable and the storage from a checkpoint.
+         */
+        void restore(const Checkpoint<T, Opt>& checkpoint)
+            requires std::copyable<T>
+        {
+            assert(m_t != nullptr and m_storage != nullptr);
+            *m_t = checkpoint.t;
+            detail::restore_storage(*m_storage, checkpoint.store);
+        }
+
+        /**
+         * @brief Create an independent owning range that continues from the current state.
+         */
+        OwnedRange<T, R, A> fork() const
+            requires std::copyable<T>
+        {
+            return OwnedRange<T, R, A>{ checkpoint() };
+        }
+
+        /**
+         * @brief Create a range that iterates the remaining values in reverse using `next_back()`.
+         *
+         * The returned range refers to the same iterable and takes over the value in the storage (if any).
+         */
+        auto rev() &
+            requires traits::HasNextBack<T>
+        {
+            auto reversed = OwnedRange<RevWrapper<T&>, R, A>{ std::in_place, underlying() };
+            reversed.underlying().set_front(std::exchange(*m_storage, Opt{}));
+            return reversed;
+        }
+
+        /**
+         * @brief Create a range that iterates the remaining values from both ends until they meet.
+         *
+         * The returned range refers to the same iterable and takes over the value in the storage (if any).
+         */
+        auto ends() &
+            requires traits::HasNextBack<T>
+        {
+            using Wrapper = EndsWrapper<T&>;
+            auto both     = OwnedRange<Wrapper, typename Wrapper::Ret, A>{ std::in_place, underlying() };
+            both.underlying().set_front(std::exchange(*m_storage, Opt{}));
+            return both;
+        }
+
+        // the returned range would refer to the iterable of a temporary
+        void rev() &&  = delete;
+        void ends() && = delete;
+
+        Iterator<T, R, A> begin()
         {
             assert(m_storage != nullptr);
-            if (*m_storage == std::nullopt) {
-                *m_storage = std::move(m_t->next());
+            if (A == Advance::Eager and not traits::OptTrait<Opt>::has_value(*m_storage)) {
+                detail::fill(*m_t, *m_storage);
             }
-            return Iterator{ m_t, &*m_storage };
+            return Iterator<T, R, A>{ m_t, &*m_storage };
         }
 
         Sentinel end() { return Sentinel{}; }
@@ -196,26 +646,28 @@ namespace opt_iter
      * @tparam Fn The type of the functor.
      * @tparam R The return type of the functor (unwrapped).
      * @tparam OwnStorage Whether the range should create the storage of the optional by its own.
+     * @tparam A When the iterator calls `next()`, see `Advance`.
      */
-    template <traits::HasCallOp Fn, OptIterRet R, bool OwnStorage>
+    template <traits::HasCallOp Fn, OptIterRet R, bool OwnStorage, Advance A = Advance::Eager>
         requires std::same_as<typename traits::OptIterTrait<Fn>::Ret, R>
     class [[nodiscard]] RangeFn
     {
     public:
         using Ret   = R;
-        using Store = std::conditional_t<OwnStorage, std::unique_ptr<std::optional<R>>, std::optional<R>*>;
+        using Opt   = traits::OptIterTrait<Fn>::Opt;
+        using Store = std::conditional_t<OwnStorage, std::unique_ptr<Opt>, Opt*>;
 
-        RangeFn(std::optional<R>& storage, Fn& fn)
-            requires std::same_as<Store, std::optional<R>*>
+        RangeFn(Opt& storage, Fn& fn)
+            requires std::same_as<Store, Opt*>
             : m_wrapper{ &fn }
             , m_storage{ &storage }
         {
         }
 
         RangeFn(Fn& fn)
-            requires std::same_as<Store, std::unique_ptr<std::optional<R>>>
+            requires std::same_as<Store, std::unique_ptr<Opt>>
             : m_wrapper{ &fn }
-            , m_storage{ std::make_unique<std::optional<R>>() }
+            , m_storage{ std::make_unique<Opt>() }
         {
         }
 
@@ -228,16 +680,56 @@ namespace opt_iter
         void clear()
         {
             assert(m_storage != nullptr);
-            *m_storage = std::nullopt;
+            traits::OptTrait<Opt>::reset(*m_storage);
+        }
+
+        /**
+         * @brief Reset the underlying iterable and clear the storage at once.
+         */
+        void reset()
+            requires traits::HasReset<Fn>
+        {
+            underlying().reset();
+            clear();
         }
 
-        Iterator<FnWrapper<Fn, R>, R> begin()
+        /**
+         * @brief Capture the state of the iterable and the storage.
+         */
+        Checkpoint<Fn, Opt> checkpoint() const
+            requires std::copyable<Fn>
+        {
+            assert(m_wrapper.fn != nullptr and m_storage != nullptr);
+            return { *m_wrapper.fn, detail::copy_storage(*m_storage) };
+        }
+
+        /**
+         * @brief Restore the state of the iterable and the storage from a checkpoint.
+         */
+        void restore(const Checkpoint<Fn, Opt>& checkpoint)
+            requires std::copyable<Fn>
+        {
+            assert(m_wrapper.fn != nullptr and m_storage != nullptr);
+            *m_wrapper.fn = checkpoint.t;
+            detail::restore_storage(*m_storage, checkpoint.store);
+        }
+
+        /**
+         * @brief Create an independent owning range that continues from the current state.
+         */
+        OwnedRangeFn<Fn, R, A> fork() const
+            requires std::copyable<Fn>
+        {
+            return OwnedRangeFn<Fn, R, A>{ checkpoint() };
+        }
+
+        Iterator<FnWrapper<Fn, R>, R, A> begin()
         {
             assert(m_storage != nullptr);
-            if (*m_storage == std::nullopt) {
-                *m_storage = std::move(m_wrapper.next());
+            if (A == Advance::Eager and not traits::OptTrait<Opt>::has_value(*m_storage)) {
+                detail::fill(m_wrapper, *m_storage);
             }
-            return Iterator{ &m_wrapper, &*m_storage };
+            return Iterator<FnWrapper<Fn, R>, R, A>{ &m_wrapper, &*m_storage };
         }
 
         Sentinel end() { return Sentinel{}; }
@@ -247,6 +739,88 @@ namespace opt_iter
         Store            m_storage = nullptr;
     };
 
+    /**
+     * @class RangeTry
+     *
+     * @brief Represents a range of an iterable that may fail, stopping at the first error.
+     *
+     * @tparam T The type of the iterable.
+     * @tparam R The return type of the iterable (unwrapped).
+     * @tparam E The error type of the iterable.
+     * @tparam OwnStorage Whether the range should create the storage of the optional by its own.
+     * @tparam A When the iterator calls `next()`, see `Advance`.
+     */
+    template <traits::HasTryNext T, OptIterRet R, typename E, bool OwnStorage, Advance A = Advance::Eager>
+        requires std::same_as<typename traits::OptIterTrait<T>::Ret, R>
+    class [[nodiscard]] RangeTry
+    {
+    public:
+        using Ret   = R;
+        using Error = E;
+        using Opt   = traits::OptIterTrait<T>::Opt;
+        using Store = std::conditional_t<OwnStorage, std::unique_ptr<Opt>, Opt*>;
+
+        RangeTry(Opt& storage, T& t)
+            requires std::same_as<Store, Opt*>
+            : m_wrapper{ &t }
+            , m_storage{ &storage }
+        {
+        }
+
+        RangeTry(T& t)
+            requires std::same_as<Store, std::unique_ptr<Opt>>
+            : m_wrapper{ &t }
+            , m_storage{ std::make_unique<Opt>() }
+        {
+        }
+
+        T& underlying() const
+        {
+            assert(m_wrapper.t != nullptr);
+            return *m_wrapper.t;
+        }
+
+        /**
+         * @brief The error that stopped the iteration, if any.
+         */
+        const std::optional<E>& error() const { return m_wrapper.error; }
+
+        /**
+         * @brief Clear the storage and the stored error so the iteration can be resumed.
+         */
+        void clear()
+        {
+            assert(m_storage != nullptr);
+            traits::OptTrait<Opt>::reset(*m_storage);
+            m_wrapper.error = std::nullopt;
+        }
+
+        /**
+         * @brief Reset the underlying iterable, clear the storage and the stored error at once.
+         */
+        void reset()
+            requires traits::HasReset<T>
+        {
+            underlying().reset();
+            clear();
+        }
+
+        Iterator<TryWrapper<T, R, E>, R, A> begin()
+        {
+            assert(m_storage != nullptr);
+            if (A == Advance::Eager and not traits::OptTrait<Opt>::has_value(*m_storage)) {
+                detail::fill(m_wrapper, *m_storage);
+            }
+            return Iterator<TryWrapper<T, R, E>, R, A>{ &m_wrapper, &*m_storage };
+        }
+
+        Sentinel end() { return Sentinel{}; }
+
+    private:
+        TryWrapper<T, R, E> m_wrapper;
+        Store               m_storage = nullptr;
+    };
+
     /**
      * @class OwnedRange
      *
@@ -254,31 +828,111 @@ namespace opt_iter
      *
      * @tparam T The type of the iterable.
      * @tparam R The return type of the iterable (unwrapped).
+     * @tparam A When the iterator calls `next()`, see `Advance`.
      */
-    template <traits::HasNext T, OptIterRet R>
+    template <traits::HasNextLike T, OptIterRet R, Advance A = Advance::Eager>
     class [[nodiscard]] OwnedRange
     {
     public:
         using Ret = R;
+        using Opt = traits::OptIterTrait<T>::Opt;
 
         template <typename... Args>
             requires std::constructible_from<T, Args...>
         OwnedRange(Args&&... args)
-            : m_data{ std::make_unique<Data>(T{ std::forward<Args>(args)... }) }
+            : m_data{ std::make_unique<Data>(std::in_place, std::forward<Args>(args)...) }
+        {
+        }
+
+        /**
+         * @brief Construct the range from a checkpoint, taking over its iterable and storage.
+         */
+        explicit OwnedRange(Checkpoint<T, Opt> checkpoint)
+            : m_data{ std::make_unique<Data>(std::in_place, std::move(checkpoint.t)) }
         {
+            m_data->store = std::move(checkpoint.store);
         }
 
         T&       underlying() { return m_data->t; }
         const T& underlying() const { return m_data->t; }
 
-        void clear() { m_data->store = std::nullopt; }
+        void clear() { traits::OptTrait<Opt>::reset(m_data->store); }
+
+        /**
+         * @brief Reset the underlying iterable and clear the storage at once.
+         */
+        void reset()
+            requires traits::HasReset<T>
+        {
+            m_data->t.reset();
+            clear();
+        }
+
+        /**
+         * @brief Capture the state of the iterable and the storage.
+         */
+        Checkpoint<T, Opt> checkpoint() const
+            requires std::copyable<T>
+        {
+            return { m_data->t, detail::copy_storage(m_data->store) };
+        }
+
+        /**
+         * @brief Restore the state of the iterable and the storage from a checkpoint.
+         */
+        void restore(const Checkpoint<T, Opt>& checkpoint)
+            requires std::copyable<T>
+        {
+            m_data->t = checkpoint.t;
+            detail::restore_storage(m_data->store, checkpoint.store);
+        }
 
-        Iterator<T, R> begin()
+        /**
+         * @brief Create an independent owning range that continues from the current state.
+         */
+        OwnedRange fork() const
+            requires std::copyable<T>
         {
-            if (m_data->store == std::nullopt) {
-                m_data->store = std::move(m_data->t.next());
+            return OwnedRange{ checkpoint() };
+        }
+
+        /**
+         * @brief Create a range that iterates the remaining values in reverse using `next_back()`.
+         *
+         * The returned range refers to the same iterable and takes over the value in the storage (if any).
+         */
+        auto rev() &
+            requires traits::HasNextBack<T>
+        {
+            auto reversed = OwnedRange<RevWrapper<T&>, R, A>{ std::in_place, m_data->t };
+            reversed.underlying().set_front(std::exchange(m_data->store, Opt{}));
+            return reversed;
+        }
+
+        /**
+         * @brief Create a range that iterates the remaining values from both ends until they meet.
+         *
+         * The returned range refers to the same iterable and takes over the value in the storage (if any).
+         */
+        auto ends() &
+            requires traits::HasNextBack<T>
+        {
+            using Wrapper = EndsWrapper<T&>;
+            auto both     = OwnedRange<Wrapper, typename Wrapper::Ret, A>{ std::in_place, m_data->t };
+            both.underlying().set_front(std::exchange(m_data->store, Opt{}));
+            return both;
+        }
+
+        // the returned range would refer to the iterable of a temporary
+        void rev() &&  = delete;
+        void ends() && = delete;
+
+        Iterator<T, R, A> begin()
+        {
+            if (A == Advance::Eager and not traits::OptTrait<Opt>::has_value(m_data->store)) {
+                detail::fill(m_data->t, m_data->store);
             }
-            return Iterator{ &m_data->t, &m_data->store };
+            return Iterator<T, R, A>{ &m_data->t, &m_data->store };
         }
 
         Sentinel end() { return Sentinel{}; }
@@ -286,8 +940,15 @@ namespace opt_iter
     private:
         struct Data
         {
-            T                t;
-            std::optional<R> store = std::nullopt;
+            // constructs the iterable in place, it doesn't need to be movable
+            template <typename... Args>
+            Data(std::in_place_t, Args&&... args)
+                : t{ std::forward<Args>(args)... }
+            {
+            }
+
+            T   t;
+            Opt store = {};
         };
 
         std::unique_ptr<Data> m_data = nullptr;
@@ -300,33 +961,83 @@ namespace opt_iter
      *
      * @tparam Fn The type of the functor.
      * @tparam R The return type of the functor (unwrapped).
+     * @tparam A When the iterator calls `next()`, see `Advance`.
      */
-    template <traits::HasCallOp Fn, OptIterRet R>
+    template <traits::HasCallOp Fn, OptIterRet R, Advance A = Advance::Eager>
         requires std::same_as<typename traits::OptIterTrait<Fn>::Ret, R>
     class [[nodiscard]] OwnedRangeFn
     {
     public:
         using Ret = R;
+        using Opt = traits::OptIterTrait<Fn>::Opt;
 
         template <typename... Args>
             requires std::constructible_from<Fn, Args...>
         OwnedRangeFn(Args&&... args)
-            : m_data{ std::make_unique<Data>(Fn{ std::forward<Args>(args)... }) }
+            : m_data{ std::make_unique<Data>(std::in_place, std::forward<Args>(args)...) }
         {
             m_data->fn_wrap.fn = &m_data->fn;
         }
 
+        /**
+         * @brief Construct the range from a checkpoint, taking over its functor and storage.
+         */
+        explicit OwnedRangeFn(Checkpoint<Fn, Opt> checkpoint)
+            : m_data{ std::make_unique<Data>(std::in_place, std::move(checkpoint.t)) }
+        {
+            m_data->fn_wrap.fn = &m_data->fn;
+            m_data->store      = std::move(checkpoint.store);
+        }
+
         Fn&       underlying() { return m_data->fn; }
         const Fn& underlying() const { return m_data->fn; }
 
-        void clear() { m_data->store = std::nullopt; }
+        void clear() { traits::OptTrait<Opt>::reset(m_data->store); }
+
+        /**
+         * @brief Reset the underlying iterable and clear the storage at once.
+         */
+        void reset()
+            requires traits::HasReset<Fn>
+        {
+            m_data->fn.reset();
+            clear();
+        }
+
+        /**
+         * @brief Capture the state of the iterable and the storage.
+         */
+        Checkpoint<Fn, Opt> checkpoint() const
+            requires std::copyable<Fn>
+        {
+            return { m_data->fn, detail::copy_storage(m_data->store) };
+        }
+
+        /**
+         * @brief Restore the state of the iterable and the storage from a checkpoint.
+         */
+        void restore(const Checkpoint<Fn, Opt>& checkpoint)
+            requires std::copyable<Fn>
+        {
+            m_data->fn = checkpoint.t;
+            detail::restore_storage(m_data->store, checkpoint.store);
+        }
 
-        Iterator<FnWrapper<Fn, R>, R> begin()
+        /**
+         * @brief Create an independent owning range that continues from the current state.
+         */
+        OwnedRangeFn fork() const
+            requires std::copyable<Fn>
         {
-            if (m_data->store == std::nullopt) {
-                m_data->store = std::move(m_data->fn_wrap.next());
+            return OwnedRangeFn{ checkpoint() };
+        }
+
+        Iterator<FnWrapper<Fn, R>, R, A> begin()
+        {
+            if (A == Advance::Eager and not traits::OptTrait<Opt>::has_value(m_data->store)) {
+                detail::fill(m_data->fn_wrap, m_data->store);
             }
-            return Iterator{ &m_data->fn_wrap, &m_data->store };
+            return Iterator<FnWrapper<Fn, R>, R, A>{ &m_data->fn_wrap, &m_data->store };
         }
 
         Sentinel end() { return Sentinel{}; }
@@ -334,38 +1045,203 @@ namespace opt_iter
     private:
         struct Data
         {
+            template <typename... Args>
+            Data(std::in_place_t, Args&&... args)
+                : fn{ std::forward<Args>(args)... }
+            {
+            }
+
             Fn               fn;
             FnWrapper<Fn, R> fn_wrap = {};
-            std::optional<R> store   = std::nullopt;
+            Opt              store   = {};
+        };
+
+        std::unique_ptr<Data> m_data = nullptr;
+    };
+
+    /**
+     * @class OwnedRangeTry
+     *
+     * @brief Represents a range of an iterable that may fail while owning the iterable.
+     *
+     * @tparam T The type of the iterable.
+     * @tparam R The return type of the iterable (unwrapped).
+     * @tparam E The error type of the iterable.
+     * @tparam A When the iterator calls `next()`, see `Advance`.
+     */
+    template <traits::HasTryNext T, OptIterRet R, typename E, Advance A = Advance::Eager>
+        requires std::same_as<typename traits::OptIterTrait<T>::Ret, R>
+    class [[nodiscard]] OwnedRangeTry
+    {
+    public:
+        using Ret   = R;
+        using Error = E;
+        using Opt   = traits::OptIterTrait<T>::Opt;
+
+        template <typename... Args>
+            requires std::constructible_from<T, Args...>
+        OwnedRangeTry(Args&&... args)
+            : m_data{ std::make_unique<Data>(std::in_place, std::forward<Args>(args)...) }
+        {
+            m_data->try_wrap.t = &m_data->t;
+        }
+
+        T&       underlying() { return m_data->t; }
+        const T& underlying() const { return m_data->t; }
+
+        /**
+         * @brief The error that stopped the iteration, if any.
+         */
+        const std::optional<E>& error() const { return m_data->try_wrap.error; }
+
+        /**
+         * @brief Clear the storage and the stored error so the iteration can be resumed.
+         */
+        void clear()
+        {
+            traits::OptTrait<Opt>::reset(m_data->store);
+            m_data->try_wrap.error = std::nullopt;
+        }
+
+        /**
+         * @brief Reset the underlying iterable, clear the storage and the stored error at once.
+         */
+        void reset()
+            requires traits::HasReset<T>
+        {
+            m_data->t.reset();
+            clear();
+        }
+
+        Iterator<TryWrapper<T, R, E>, R, A> begin()
+        {
+            if (A == Advance::Eager and not traits::OptTrait<Opt>::has_value(m_data->store)) {
+                detail::fill(m_data->try_wrap, m_data->store);
+            }
+            return Iterator<TryWrapper<T, R, E>, R, A>{ &m_data->try_wrap, &m_data->store };
+        }
+
+        Sentinel end() { return Sentinel{}; }
+
+    private:
+        struct Data
+        {
+            template <typename... Args>
+            Data(std::in_place_t, Args&&... args)
+                : t{ std::forward<Args>(args)... }
+            {
+            }
+
+            T                   t;
+            TryWrapper<T, R, E> try_wrap = {};
+            Opt                 store    = {};
         };
 
         std::unique_ptr<Data> m_data = nullptr;
     };
 
+    /**
+     * @class DeferredRange
+     *
+     * @brief Represents an owning range whose iterable is only constructed on the first `begin()` call.
+     *
+     * @tparam Owned The owning range type to be constructed (OwnedRange, OwnedRangeFn, or OwnedRangeTry).
+     * @tparam Args The arguments to construct the owning range.
+     *
+     * The arguments are stored by value until the first `begin()` call, when they are moved into the
+     * constructor of the iterable. No allocation happens and the iterable is never constructed if the range
+     * is never iterated.
+     */
+    template <typename Owned, typename... Args>
+        requires std::constructible_from<Owned, Args...>
+    class [[nodiscard]] DeferredRange
+    {
+    public:
+        using Ret = Owned::Ret;
+
+        template <typename... Ts>
+            requires std::constructible_from<std::tuple<Args...>, Ts...>
+        DeferredRange(std::in_place_t, Ts&&... args)
+            : m_args{ std::forward<Ts>(args)... }
+        {
+        }
+
+        /**
+         * @brief Whether the iterable has already been constructed.
+         */
+        bool constructed() const { return m_range.has_value(); }
+
+        /**
+         * @brief Get the underlying iterable, constructing it if it hasn't been constructed yet.
+         */
+        auto& underlying() { return construct().underlying(); }
+
+        void clear()
+        {
+            if (m_range.has_value()) {
+                m_range->clear();
+            }
+        }
+
+        /**
+         * @brief Reset the underlying iterable and clear the storage at once, if already constructed.
+         */
+        void reset()
+            requires requires (Owned& owned) { owned.reset(); }
+        {
+            if (m_range.has_value()) {
+                m_range->reset();
+            }
+        }
+
+        auto begin() { return construct().begin(); }
+
+        Sentinel end() { return Sentinel{}; }
+
+    private:
+        Owned& construct()
+        {
+            if (not m_range.has_value()) {
+                std::apply(
+                    [&](auto&&... args) { m_range.emplace(std::forward<decltype(args)>(args)...); },
+                    std::move(m_args)
+                );
+            }
+            return *m_range;
+        }
+
+        std::tuple<Args...>  m_args;
+        std::optional<Owned> m_range = std::nullopt;
+    };
+
     /**
      * @brief Helper function to create a Range or RangeFn.
      *
+     * @tparam A When the iterator calls `next()`, see `Advance`.
      * @tparam T The type of the iterable.
      *
      * @param t The iterable to be wrapped.
      *
-     * @return Range if the iterable has `next()` member function, RangeFn if the iterable is a functor.
+     * @return Range if the iterable has `next()` member function, RangeTry if `next()` returns a
+     * `std::expected`, RangeFn if the iterable is a functor.
      *
      * The returned object will make its own storage for the optional value. Since the type itself needs to
      * be movable while the storage must be stay in one place, the storage is allocated in the heap. Use
      * `make_with()` if you want to use your own storage. Or since the storage is already on the heap
      * anyway, you can let the `Range` itself to also own the iterable by using `make_owned()`.
      */
-    template <OptIter T>
+    template <Advance A = Advance::Eager, OptIter T>
     auto make(T& t)
     {
         using Ret = traits::OptIterTrait<T>::Ret;
         if constexpr (traits::HasNext<T> and traits::HasCallOp<T>) {
-            return Range<T, Ret, true>{ t };
-        } else if constexpr (traits::HasNext<T>) {
-            return Range<T, Ret, true>{ t };
+            return Range<T, Ret, true, A>{ t };
+        } else if constexpr (traits::HasNextLike<T>) {
+            return Range<T, Ret, true, A>{ t };
+        } else if constexpr (traits::HasTryNext<T>) {
+            return RangeTry<T, Ret, typename traits::OptIterTrait<T>::Error, true, A>{ t };
         } else if constexpr (traits::HasCallOp<T>) {
-            return RangeFn<T, Ret, true>{ t };
+            return RangeFn<T, Ret, true, A>{ t };
         } else {
             static_assert(false, "Invalid type, should not reach here.");
         }
@@ -375,72 +1251,189 @@ namespace opt_iter
      * @brief Helper function to create an OwnedRange or OwnedRangeFn.
      *
      * @tparam T The type of the iterable.
+     * @tparam A When the iterator calls `next()`, see `Advance`.
      * @tparam Args The arguments to construct the iterable.
      *
      * @param args The arguments to construct the iterable.
      *
-     * @return OwnedRange if the iterable has `next()` member function, OwnedRangeFn if the iterable is a
-     * functor.
+     * @return OwnedRange if the iterable has `next()` member function, OwnedRangeTry if `next()` returns a
+     * `std::expected`, OwnedRangeFn if the iterable is a functor.
      *
-     * The returned object will own the iterable and make its own storage for the optional value.
+     * The returned object will own the iterable and make its own storage for the optional value. The
+     * iterable is constructed in place from the arguments, so it doesn't need to be movable.
      */
-    template <OptIter T, typename... Args>
+    template <OptIter T, Advance A = Advance::Eager, typename... Args>
         requires std::constructible_from<T, Args...>
     auto make_owned(Args&&... args)
     {
         using Ret = traits::OptIterTrait<T>::Ret;
         if constexpr (traits::HasNext<T> and traits::HasCallOp<T>) {
-            return OwnedRange<T, Ret>{ std::forward<Args>(args)... };
-        } else if constexpr (traits::HasNext<T>) {
-            return OwnedRange<T, Ret>{ std::forward<Args>(args)... };
+            return OwnedRange<T, Ret, A>{ std::forward<Args>(args)... };
+        } else if constexpr (traits::HasNextLike<T>) {
+            return OwnedRange<T, Ret, A>{ std::forward<Args>(args)... };
+        } else if constexpr (traits::HasTryNext<T>) {
+            using Err = traits::OptIterTrait<T>::Error;
+            return OwnedRangeTry<T, Ret, Err, A>{ std::forward<Args>(args)... };
         } else if constexpr (traits::HasCallOp<T>) {
-            return OwnedRangeFn<T, Ret>{ std::forward<Args>(args)... };
+            return OwnedRangeFn<T, Ret, A>{ std::forward<Args>(args)... };
         } else {
             static_assert(false, "Invalid type, should not reach here.");
         }
     }
 
+    /**
+     * @brief Helper function to create a DeferredRange.
+     *
+     * @tparam T The type of the iterable.
+     * @tparam A When the iterator calls `next()`, see `Advance`.
+     * @tparam Args The arguments to construct the iterable.
+     *
+     * @param args The arguments to construct the iterable.
+     *
+     * @return DeferredRange that constructs the same range as `make_owned()` on its first `begin()` call.
+     *
+     * The arguments are decayed and stored by value, use `std::ref` to pass an argument by reference.
+     */
+    template <OptIter T, Advance A = Advance::Eager, typename... Args>
+        requires std::constructible_from<T, std::unwrap_ref_decay_t<Args>...>
+    auto make_deferred(Args&&... args)
+    {
+        using Owned = decltype(make_owned<T, A>(std::declval<std::unwrap_ref_decay_t<Args>>()...));
+        return DeferredRange<Owned, std::unwrap_ref_decay_t<Args>...>{ std::in_place, std::forward<Args>(args)... };
+    }
+
     /**
      * @brief Helper function to create a Range or RangeFn.
      *
+     * @tparam A When the iterator calls `next()`, see `Advance`.
      * @tparam T The type of the iterable.
      *
-     * @param storage The storage for the optional value.
+     * @param storage The storage for the optional value (the optional-like type returned by the iterable).
      * @param t The iterable to be wrapped.
      *
-     * @return Range if the iterable has `next()` member function, RangeFn if the iterable is a functor.
+     * @return Range if the iterable has `next()` member function, RangeTry if `next()` returns a
+     * `std::expected`, RangeFn if the iterable is a functor.
      *
      * The returned object will use the provided storage for the optional value. The storage must be valid
      * for the lifetime of the returned object.
      */
-    template <OptIter T>
-    auto make_with(std::optional<typename traits::OptIterTrait<T>::Ret>& storage, T& t)
+    template <Advance A = Advance::Eager, OptIter T>
+    auto make_with(typename traits::OptIterTrait<T>::Opt& storage, T& t)
     {
         using Ret = traits::OptIterTrait<T>::Ret;
         if constexpr (traits::HasNext<T> and traits::HasCallOp<T>) {
-            return Range<T, Ret, false>{ storage, t };
-        } else if constexpr (traits::HasNext<T>) {
-            return Range<T, Ret, false>{ storage, t };
+            return Range<T, Ret, false, A>{ storage, t };
+        } else if constexpr (traits::HasNextLike<T>) {
+            return Range<T, Ret, false, A>{ storage, t };
+        } else if constexpr (traits::HasTryNext<T>) {
+            return RangeTry<T, Ret, typename traits::OptIterTrait<T>::Error, false, A>{ storage, t };
         } else if constexpr (traits::HasCallOp<T>) {
-            return RangeFn<T, Ret, false>{ storage, t };
+            return RangeFn<T, Ret, false, A>{ storage, t };
         } else {
             static_assert(false, "Invalid type, should not reach here.");
         }
     }
 
+    /**
+     * @brief Helper function to create an element-wise OwnedRange from an iterable that yields spans.
+     *
+     * @tparam A When the iterator calls `next()`, see `Advance`.
+     * @tparam T The type of the iterable.
+     *
+     * @param t The iterable to be wrapped.
+     *
+     * @return OwnedRange of SpanWrapper that refers to the iterable.
+     *
+     * The returned object only holds a reference to the iterable, the iterable must outlive it.
+     */
+    template <Advance A = Advance::Eager, traits::HasSpanNext T>
+    auto make_span(T& t)
+    {
+        using Wrapper = SpanWrapper<T&>;
+        return OwnedRange<Wrapper, typename Wrapper::Ret, A>{ std::in_place, t };
+    }
+
+    /**
+     * @brief Helper function to create an element-wise OwnedRange from an iterable that yields spans.
+     *
+     * @tparam T The type of the iterable.
+     * @tparam A When the iterator calls `next()`, see `Advance`.
+     * @tparam Args The arguments to construct the iterable.
+     *
+     * @param args The arguments to construct the iterable.
+     *
+     * @return OwnedRange of SpanWrapper that owns the iterable.
+     */
+    template <traits::HasSpanNext T, Advance A = Advance::Eager, typename... Args>
+        requires std::constructible_from<T, Args...>
+    auto make_span_owned(Args&&... args)
+    {
+        using Wrapper = SpanWrapper<T>;
+        return OwnedRange<Wrapper, typename Wrapper::Ret, A>{ std::in_place, std::forward<Args>(args)... };
+    }
+
     /**
      * @brief Helper function to create an OwnedRangeFn from a lambda.
      *
+     * @tparam A When the iterator calls `next()`, see `Advance`.
+     *
      * @param fn A lambda function to be wrapped.
      *
      * @return OwnedRangeFn that wraps the lambda function.
      */
-    template <traits::HasCallOp Fn>
+    template <Advance A = Advance::Eager, traits::HasCallOp Fn>
     auto make_lambda(Fn&& fn)
     {
         using Ret = traits::OptIterTrait<Fn>::Ret;
-        return OwnedRangeFn<Fn, Ret>{ std::forward<Fn>(fn) };
+        return OwnedRangeFn<Fn, Ret, A>{ std::forward<Fn>(fn) };
+    }
+
+#if defined(__cpp_lib_expected)
+    /**
+     * @brief Collect a range of a fallible iterable into a container.
+     *
+     * @tparam Container The container type to collect into.
+     * @tparam Rng The type of the range (RangeTry or OwnedRangeTry).
+     *
+     * @param range The range to be collected.
+     *
+     * @return The collected container, or the error that stopped the iteration.
+     *
+     * The values produced before the error are discarded when an error occurs.
+     */
+    template <typename Container, typename Rng>
+        requires requires (Rng& r) { r.error(); }
+    std::expected<Container, typename std::remove_cvref_t<Rng>::Error> try_collect(Rng&& range)
+    {
+        auto container = Container{};
+        for (auto&& v : range) {
+            container.insert(container.end(), std::move(v));
+        }
+
+        if (range.error().has_value()) {
+            return std::unexpected{ *range.error() };
+        }
+        return container;
+    }
+
+    /**
+     * @brief Collect a range of a fallible iterable into a container, deducing the element type.
+     *
+     * @tparam Container The container template to collect into (e.g. `std::vector`).
+     * @tparam Rng The type of the range (RangeTry or OwnedRangeTry).
+     *
+     * @param range The range to be collected.
+     *
+     * @return The collected container, or the error that stopped the iteration.
+     */
+    template <template <typename...> typename Container, typename Rng>
+        requires requires (Rng& r) { r.error(); }
+    auto try_collect(Rng&& range)
+    {
+        using Ret = typename std::remove_cvref_t<Rng>::Ret;
+        return try_collect<Container<Ret>>(std::forward<Rng>(range));
     }
+#endif
 }
 
 #endif /* end of include guard: OPT_ITER_OPT_ITER_HPP */
@@ -0,0 +1,235 @@
+#ifndef OPT_ITER_POOL_HPP
+#define OPT_ITER_POOL_HPP
+
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace opt_iter
+{
+    template <std::default_initializable R>
+    class Pool;
+
+    namespace detail
+    {
+        /**
+         * @brief The free objects of a pool and the number of handles still alive.
+         *
+         * The state outlives the pool if there are handles still alive when the pool is destroyed, the last
+         * handle deletes it. Not thread-safe: the handles must be released on the thread that owns the pool.
+         */
+        template <typename R>
+        struct PoolState
+        {
+            ~PoolState()
+            {
+                for (auto* object : free) {
+                    delete object;
+                }
+            }
+
+            void release(R* object)
+            {
+                assert(alive > 0);
+                --alive;
+
+                if (closed) {
+                    delete object;
+                    if (alive == 0) {
+                        delete this;
+                    }
+                    return;
+                }
+
+                if (free.size() >= max_free) {
+                    delete object;
+                    return;
+                }
+                free.push_back(object);
+            }
+
+            std::vector<R*> free;
+            std::size_t     max_free = 0;
+            std::size_t     alive    = 0;
+            bool            closed   = false;
+        };
+    }
+
+    /**
+     * @class Pooled
+     *
+     * @brief A handle to an object acquired from a `Pool`, returns the object to the pool on destruction.
+     *
+     * @tparam R The type of the object.
+     *
+     * Moving the handle only moves the pointers, the object itself is never moved or copied. The object keeps
+     * its resources (e.g. the capacity of a `std::vector`) when it's returned to the pool.
+     */
+    template <std::default_initializable R>
+    class [[nodiscard]] Pooled
+    {
+    public:
+        Pooled() = default;
+
+        Pooled(Pooled&& other) noexcept
+            : m_state{ std::exchange(other.m_state, nullptr) }
+            , m_object{ std::exchange(other.m_object, nullptr) }
+        {
+        }
+
+        Pooled& operator=(Pooled&& other) noexcept
+        {
+            if (this != &other) {
+                release();
+                m_state  = std::exchange(other.m_state, nullptr);
+                m_object = std::exchange(other.m_object, nullptr);
+            }
+            return *this;
+        }
+
+        ~Pooled() { release(); }
+
+        R& operator*() const
+        {
+            assert(m_object != nullptr);
+            return *m_object;
+        }
+
+        R* operator->() const
+        {
+            assert(m_object != nullptr);
+            return m_object;
+        }
+
+        R*       get() const { return m_object; }
+        explicit operator bool() const { return m_object != nullptr; }
+
+    private:
+        friend Pool<R>;
+
+        Pooled(detail::PoolState<R>* state, R* object)
+            : m_state{ state }
+            , m_object{ object }
+        {
+        }
+
+        void release()
+        {
+            if (m_object != nullptr) {
+                m_state->release(std::exchange(m_object, nullptr));
+                m_state = nullptr;
+            }
+        }
+
+        detail::PoolState<R>* m_state  = nullptr;
+        R*                    m_object = nullptr;
+    };
+
+    /**
+     * @class Pool
+     *
+     * @brief Recycles heavyweight objects (e.g. `std::vector`, `std::string`) yielded by a generator.
+     *
+     * @tparam R The type of the object.
+     *
+     * The generator acquires an object with `acquire()` and yields the handle, the consumer drops the handle
+     * after use and the object goes back to the pool with its resources. At steady state no object is
+     * allocated. An acquired object has the content it had when it was released, clear it before reuse.
+     *
+     * ```cpp
+     * struct RecordReader
+     * {
+     *     std::optional<opt_iter::Pooled<std::string>> next()
+     *     {
+     *         auto record = m_pool.acquire();
+     *         record->clear();
+     *         // fill the record...
+     *         return record;
+     *     }
+     *
+     *     opt_iter::Pool<std::string> m_pool;
+     * };
+     * ```
+     */
+    template <std::default_initializable R>
+    class [[nodiscard]] Pool
+    {
+    public:
+        Pool()
+            : Pool{ 64 }
+        {
+        }
+
+        /**
+         * @param max_free The maximum number of free objects kept in the pool, the rest are deleted.
+         */
+        explicit Pool(std::size_t max_free)
+            : m_state{ new detail::PoolState<R>{} }
+        {
+            m_state->max_free = max_free;
+            m_state->free.reserve(max_free);
+        }
+
+        Pool(Pool&& other) noexcept
+            : m_state{ std::exchange(other.m_state, nullptr) }
+        {
+        }
+
+        Pool& operator=(Pool&& other) noexcept
+        {
+            if (this != &other) {
+                close();
+                m_state = std::exchange(other.m_state, nullptr);
+            }
+            return *this;
+        }
+
+        ~Pool() { close(); }
+
+        /**
+         * @brief Take a free object from the pool, or allocate a new one if there is none.
+         */
+        Pooled<R> acquire()
+        {
+            assert(m_state != nullptr);
+
+            auto* object = static_cast<R*>(nullptr);
+            if (m_state->free.empty()) {
+                object = new R{};
+            } else {
+                object = m_state->free.back();
+                m_state->free.pop_back();
+            }
+
+            ++m_state->alive;
+            return Pooled<R>{ m_state, object };
+        }
+
+        std::size_t free_count() const { return m_state->free.size(); }
+        std::size_t alive_count() const { return m_state->alive; }
+
+    private:
+        void close()
+        {
+            if (m_state == nullptr) {
+                return;
+            }
+            if (m_state->alive == 0) {
+                delete m_state;
+            } else {
+                for (auto* object : std::exchange(m_state->free, {})) {
+                    delete object;
+                }
+                m_state->closed = true;
+            }
+            m_state = nullptr;
+        }
+
+        detail::PoolState<R>* m_state;
+    };
+}
+
+#endif /* end of include guard: OPT_ITER_POOL_HPP */
@@ -0,0 +1,378 @@
+#ifndef OPT_ITER_SEGMENTED_HPP
+#define OPT_ITER_SEGMENTED_HPP
+
+#include "algorithm.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdlib>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <ranges>
+#include <span>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#    include <sys/mman.h>
+#endif
+
+namespace opt_iter
+{
+    /**
+     * @brief The kind of pages backing the segments of `Segmented`.
+     */
+    enum class Pages
+    {
+        Regular,
+        Huge,    // transparent huge pages on Linux for segments of at least 2 MiB, regular pages elsewhere
+    };
+
+    namespace detail
+    {
+        inline constexpr std::size_t huge_page_size = std::size_t{ 2 } << 20;
+
+        inline void* allocate_segment(std::size_t bytes, std::size_t alignment, Pages pages)
+        {
+#if defined(__linux__)
+            if (pages == Pages::Huge and bytes >= huge_page_size) {
+                auto rounded = (bytes + huge_page_size - 1) / huge_page_size * huge_page_size;
+                auto memory  = std::aligned_alloc(huge_page_size, rounded);
+                if (memory == nullptr) {
+                    throw std::bad_alloc{};
+                }
+                ::madvise(memory, rounded, MADV_HUGEPAGE);
+                return memory;
+            }
+#endif
+            static_cast<void>(pages);
+            return ::operator new(bytes, std::align_val_t{ alignment });
+        }
+
+        inline void deallocate_segment(void* memory, std::size_t bytes, std::size_t alignment, Pages pages) noexcept
+        {
+#if defined(__linux__)
+            if (pages == Pages::Huge and bytes >= huge_page_size) {
+                std::free(memory);
+                return;
+            }
+#endif
+            static_cast<void>(pages);
+            ::operator delete(memory, std::align_val_t{ alignment });
+        }
+    }
+
+    /**
+     * @class Segmented
+     *
+     * @brief Sequence container made of geometrically growing segments, the values are never relocated.
+     *
+     * @tparam T The type of the values.
+     *
+     * Segment `k` has the capacity of `first * 2^k` values. When a segment is full the next one is allocated
+     * and the existing values stay where they are, so growing never copies or moves them, the addresses of
+     * the values are stable, and the memory never spikes to the old and the new buffer at once (as it does
+     * when `std::vector` reallocates). Indexing is O(1), contiguous access is provided per segment with
+     * `segment(k)`; `to_vector()` flattens the values when a single contiguous buffer is needed.
+     */
+    template <typename T>
+    class [[nodiscard]] Segmented
+    {
+    public:
+        template <bool Const>
+        class Iterator;
+
+        using value_type     = T;
+        using iterator       = Iterator<false>;
+        using const_iterator = Iterator<true>;
+
+        /**
+         * @param first The capacity of the first segment, in number of values.
+         * @param pages The kind of pages backing the segments.
+         */
+        explicit Segmented(std::size_t first = default_first(), Pages pages = Pages::Regular)
+            : m_first{ std::max(first, std::size_t{ 1 }) }
+            , m_pages{ pages }
+        {
+        }
+
+        Segmented(Segmented&& other) noexcept
+            : m_segments{ std::exchange(other.m_segments, {}) }
+            , m_first{ other.m_first }
+            , m_size{ std::exchange(other.m_size, 0) }
+            , m_pages{ other.m_pages }
+        {
+        }
+
+        Segmented& operator=(Segmented&& other) noexcept
+        {
+            if (this != &other) {
+                clear();
+                m_segments = std::exchange(other.m_segments, {});
+                m_first    = other.m_first;
+                m_size     = std::exchange(other.m_size, 0);
+                m_pages    = other.m_pages;
+            }
+            return *this;
+        }
+
+        Segmented(const Segmented&)            = delete;
+        Segmented& operator=(const Segmented&) = delete;
+
+        ~Segmented() { clear(); }
+
+        static constexpr std::size_t default_first()
+        {
+            return std::max(std::size_t{ 4096 } / sizeof(T), std::size_t{ 16 });
+        }
+
+        template <typename... Args>
+            requires std::constructible_from<T, Args...>
+        T& emplace_back(Args&&... args)
+        {
+            auto [k, offset] = locate(m_size);
+            if (k == m_segments.size()) {
+                m_segments.reserve(k + 1);    // push_back can't throw after the segment is allocated
+                m_segments.push_back(allocate(k));
+            }
+
+            auto* value = std::construct_at(m_segments[k] + offset, std::forward<Args>(args)...);
+            ++m_size;
+            return *value;
+        }
+
+        void push_back(const T& value) { emplace_back(value); }
+        void push_back(T&& value) { emplace_back(std::move(value)); }
+
+        std::size_t size() const { return m_size; }
+        bool        empty() const { return m_size == 0; }
+
+        T& operator[](std::size_t index)
+        {
+            assert(index < m_size);
+            auto [k, offset] = locate(index);
+            return m_segments[k][offset];
+        }
+
+        const T& operator[](std::size_t index) const
+        {
+            assert(index < m_size);
+            auto [k, offset] = locate(index);
+            return m_segments[k][offset];
+        }
+
+        /**
+         * @brief The number of allocated segments.
+         */
+        std::size_t segment_count() const { return m_segments.size(); }
+
+        /**
+         * @brief The values stored in segment `k`, contiguous.
+         */
+        std::span<T> segment(std::size_t k) { return { m_segments[k], segment_size(k) }; }
+        std::span<const T> segment(std::size_t k) const { return { m_segments[k], segment_size(k) }; }
+
+        iterator       begin() { return iterator{ this, 0 }; }
+        iterator       end() { return iterator{ this, m_size }; }
+        const_iterator begin() const { return const_iterator{ this, 0 }; }
+        const_iterator end() const { return const_iterator{ this, m_size }; }
+
+        /**
+         * @brief Copy the values into a single contiguous `std::vector`.
+         */
+        std::vector<T> to_vector() const&
+            requires std::copy_constructible<T>
+        {
+            auto values = std::vector<T>{};
+            values.reserve(m_size);
+            for (auto k = std::size_t{ 0 }; k < m_segments.size(); ++k) {
+                auto values_k = segment(k);
+                values.insert(values.end(), values_k.begin(), values_k.end());
+            }
+            return values;
+        }
+
+        /**
+         * @brief Move the values into a single contiguous `std::vector`, each segment is freed once moved.
+         */
+        std::vector<T> to_vector() &&
+        {
+            auto values = std::vector<T>{};
+            values.reserve(m_size);
+            for (auto k = std::size_t{ 0 }; k < m_segments.size(); ++k) {
+                auto values_k = segment(k);
+                std::ranges::move(values_k, std::back_inserter(values));
+                std::destroy(values_k.begin(), values_k.end());
+                deallocate(k);
+            }
+            m_segments.clear();
+            m_size = 0;
+            return values;
+        }
+
+        void clear()
+        {
+            for (auto k = std::size_t{ 0 }; k < m_segments.size(); ++k) {
+                auto values_k = segment(k);
+                std::destroy(values_k.begin(), values_k.end());
+                deallocate(k);
+            }
+            m_segments.clear();
+            m_size = 0;
+        }
+
+    private:
+        struct Location
+        {
+            std::size_t segment;
+            std::size_t offset;
+        };
+
+        // segment k starts at index first * (2^k - 1)
+        Location locate(std::size_t index) const
+        {
+            auto k = static_cast<std::size_t>(std::bit_width(index / m_first + 1)) - 1;
+            return { k, index - segment_start(k) };
+        }
+
+        std::size_t segment_start(std::size_t k) const { return m_first * ((std::size_t{ 1 } << k) - 1); }
+        std::size_t segment_capacity(std::size_t k) const { return m_first << k; }
+
+        std::size_t segment_size(std::size_t k) const
+        {
+            return std::min(m_size - segment_start(k), segment_capacity(k));
+        }
+
+        T* allocate(std::size_t k)
+        {
+            return static_cast<T*>(detail::allocate_segment(segment_capacity(k) * sizeof(T), alignof(T), m_pages));
+        }
+
+        void deallocate(std::size_t k) noexcept
+        {
+            detail::deallocate_segment(m_segments[k], segment_capacity(k) * sizeof(T), alignof(T), m_pages);
+        }
+
+        std::vector<T*> m_segments;
+        std::size_t     m_first;
+        std::size_t     m_size = 0;
+        Pages           m_pages;
+    };
+
+    /**
+     * @class Segmented::Iterator
+     *
+     * @brief Random access iterator over the values of `Segmented`.
+     */
+    template <typename T>
+    template <bool Const>
+    class Segmented<T>::Iterator
+    {
+    public:
+        using Parent = std::conditional_t<Const, const Segmented, Segmented>;
+
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using reference         = std::conditional_t<Const, const T&, T&>;
+
+        Iterator() = default;
+
+        Iterator(Parent* parent, std::size_t index)
+            : m_parent{ parent }
+            , m_index{ index }
+        {
+        }
+
+        reference operator*() const { return (*m_parent)[m_index]; }
+        reference operator[](difference_type n) const { return (*m_parent)[m_index + static_cast<std::size_t>(n)]; }
+
+        Iterator& operator++()
+        {
+            ++m_index;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            auto copy = *this;
+            ++m_index;
+            return copy;
+        }
+
+        Iterator& operator--()
+        {
+            --m_index;
+            return *this;
+        }
+
+        Iterator operator--(int)
+        {
+            auto copy = *this;
+            --m_index;
+            return copy;
+        }
+
+        Iterator& operator+=(difference_type n)
+        {
+            m_index += static_cast<std::size_t>(n);
+            return *this;
+        }
+
+        Iterator& operator-=(difference_type n)
+        {
+            m_index -= static_cast<std::size_t>(n);
+            return *this;
+        }
+
+        friend Iterator operator+(Iterator it, difference_type n) { return it += n; }
+        friend Iterator operator+(difference_type n, Iterator it) { return it += n; }
+        friend Iterator operator-(Iterator it, difference_type n) { return it -= n; }
+
+        friend difference_type operator-(const Iterator& lhs, const Iterator& rhs)
+        {
+            return static_cast<difference_type>(lhs.m_index) - static_cast<difference_type>(rhs.m_index);
+        }
+
+        friend bool operator==(const Iterator& lhs, const Iterator& rhs) { return lhs.m_index == rhs.m_index; }
+        friend auto operator<=>(const Iterator& lhs, const Iterator& rhs) { return lhs.m_index <=> rhs.m_index; }
+
+    private:
+        Parent*     m_parent = nullptr;
+        std::size_t m_index  = 0;
+    };
+
+    /**
+     * @brief Collect the values of a range into `Segmented`, the collected values are never relocated.
+     *
+     * If the size of the range is known (see `StaticSizedRange` and `std::ranges::sized_range`), the first
+     * segment has exactly that capacity.
+     *
+     * @param range The range to collect.
+     * @param pages The kind of pages backing the segments.
+     */
+    template <std::ranges::input_range Rng>
+    auto collect_segmented(Rng&& range, Pages pages = Pages::Regular)
+    {
+        using Value = std::ranges::range_value_t<Rng>;
+
+        auto first = Segmented<Value>::default_first();
+        if constexpr (StaticSizedRange<Rng>) {
+            first = std::max(detail::static_size_v<Rng>, std::size_t{ 1 });
+        } else if constexpr (std::ranges::sized_range<Rng>) {
+            first = std::max(static_cast<std::size_t>(std::ranges::size(range)), std::size_t{ 1 });
+        }
+
+        auto values = Segmented<Value>{ first, pages };
+        opt_iter::for_each(std::forward<Rng>(range), [&](auto&& value) {
+            values.emplace_back(std::forward<decltype(value)>(value));
+        });
+        return values;
+    }
+}
+
+#endif /* end of include guard: OPT_ITER_SEGMENTED_HPP */
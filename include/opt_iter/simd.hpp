@@ -0,0 +1,700 @@
+#ifndef OPT_ITER_SIMD_HPP
+#define OPT_ITER_SIMD_HPP
+
+#include "adapt.hpp"
+#include "traits.hpp"
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if (defined(__x86_64__) or defined(__i386__)) and (defined(__GNUC__) or defined(__clang__))
+#    define OPT_ITER_SIMD_X86 1
+#    include <immintrin.h>
+#else
+#    define OPT_ITER_SIMD_X86 0
+#endif
+
+/**
+ * Block-wise filtering of arithmetic values with SIMD.
+ *
+ * `simd::filter` pulls the values of its parent into fixed-width blocks, evaluates the predicate over a whole
+ * block at once and packs the values that satisfy it with a compress-store, so there is no branch per value.
+ * The predicates built by `simd::less`, `simd::greater`, ..., `simd::any_bits`, and `simd::no_bits` are
+ * evaluated with AVX2 or SSSE3 (chosen at runtime) for 32-bit values (`int`, `unsigned`, `float`); other
+ * predicates and value types use a scalar loop that is still branchless.
+ *
+ * ```cpp
+ * for (auto v : opt_iter::simd::filter(IntGen{ &rng }, opt_iter::simd::no_bits(1)) | std::views::take(10)) { ... }
+ * ```
+ */
+namespace opt_iter::simd
+{
+    /**
+     * @brief The instruction set used to evaluate the predicates.
+     */
+    enum class Isa
+    {
+        Scalar,
+        Ssse3,
+        Avx2,
+    };
+
+    /**
+     * @brief The comparison done by a vectorizable predicate, `Lhs` is the value and `Rhs` the operand.
+     */
+    enum class Cmp
+    {
+        Less,
+        LessEqual,
+        Greater,
+        GreaterEqual,
+        Equal,
+        NotEqual,
+        AnyBits,    // (value & operand) != 0
+        NoBits,     // (value & operand) == 0
+    };
+
+    /**
+     * @class Predicate
+     *
+     * @brief Predicate that compares a value with an operand, can be evaluated over a whole block with SIMD.
+     *
+     * @tparam C The comparison.
+     * @tparam V The type of the operand, converted to the type of the values before the comparison.
+     */
+    template <Cmp C, typename V>
+    struct Predicate
+    {
+        static constexpr Cmp cmp = C;
+
+        template <typename T>
+            requires std::is_arithmetic_v<T>
+        bool operator()(T value) const
+        {
+            auto rhs = static_cast<T>(operand);
+            if constexpr (C == Cmp::Less) {
+                return value < rhs;
+            } else if constexpr (C == Cmp::LessEqual) {
+                return value <= rhs;
+            } else if constexpr (C == Cmp::Greater) {
+                return value > rhs;
+            } else if constexpr (C == Cmp::GreaterEqual) {
+                return value >= rhs;
+            } else if constexpr (C == Cmp::Equal) {
+                return value == rhs;
+            } else if constexpr (C == Cmp::NotEqual) {
+                return value != rhs;
+            } else if constexpr (C == Cmp::AnyBits) {
+                return (value & rhs) != 0;
+            } else {
+                return (value & rhs) == 0;
+            }
+        }
+
+        V operand;
+    };
+
+    template <typename V>
+    Predicate<Cmp::Less, V> less(V operand)
+    {
+        return { operand };
+    }
+
+    template <typename V>
+    Predicate<Cmp::LessEqual, V> less_equal(V operand)
+    {
+        return { operand };
+    }
+
+    template <typename V>
+    Predicate<Cmp::Greater, V> greater(V operand)
+    {
+        return { operand };
+    }
+
+    template <typename V>
+    Predicate<Cmp::GreaterEqual, V> greater_equal(V operand)
+    {
+        return { operand };
+    }
+
+    template <typename V>
+    Predicate<Cmp::Equal, V> equal_to(V operand)
+    {
+        return { operand };
+    }
+
+    template <typename V>
+    Predicate<Cmp::NotEqual, V> not_equal_to(V operand)
+    {
+        return { operand };
+    }
+
+    template <std::integral V>
+    Predicate<Cmp::AnyBits, V> any_bits(V mask)
+    {
+        return { mask };
+    }
+
+    template <std::integral V>
+    Predicate<Cmp::NoBits, V> no_bits(V mask)
+    {
+        return { mask };
+    }
+
+    namespace detail
+    {
+        template <typename Pred>
+        struct IsPredicate : std::false_type
+        {
+        };
+
+        template <Cmp C, typename V>
+        struct IsPredicate<Predicate<C, V>> : std::true_type
+        {
+        };
+
+        // values that fit the 32-bit lanes of the vector kernels
+        template <typename T>
+        concept Lane32 = sizeof(T) == 4 and (std::integral<T> or std::same_as<T, float>);
+
+        template <typename T, typename Pred>
+        concept Vectorizable = Lane32<T> and IsPredicate<Pred>::value
+                           and (std::integral<T> or (Pred::cmp != Cmp::AnyBits and Pred::cmp != Cmp::NoBits));
+
+        inline Isa supported_isa()
+        {
+#if OPT_ITER_SIMD_X86
+            static const auto isa = [] {
+                __builtin_cpu_init();
+                if (__builtin_cpu_supports("avx2")) {
+                    return Isa::Avx2;
+                }
+                if (__builtin_cpu_supports("ssse3")) {
+                    return Isa::Ssse3;
+                }
+                return Isa::Scalar;
+            }();
+            return isa;
+#else
+            return Isa::Scalar;
+#endif
+        }
+
+        inline std::atomic<Isa>& selected_isa()
+        {
+            static auto isa = std::atomic<Isa>{ supported_isa() };
+            return isa;
+        }
+
+        /**
+         * @brief Branchless filter of a block: every value is written and the output only advances on a match.
+         */
+        template <typename T, typename Pred>
+        std::size_t filter_scalar(const T* in, std::size_t n, T* out, const Pred& pred)
+        {
+            auto count = std::size_t{ 0 };
+            for (auto i = std::size_t{ 0 }; i < n; ++i) {
+                out[count]  = in[i];
+                count      += static_cast<std::size_t>(static_cast<bool>(std::invoke(pred, in[i])));
+            }
+            return count;
+        }
+
+#if OPT_ITER_SIMD_X86
+        // the indices of the set bits of each 8-bit mask, packed to the front
+        inline constexpr auto compress_lut_8 = [] {
+            auto lut = std::array<std::array<std::uint8_t, 8>, 256>{};
+            for (auto mask = std::size_t{ 0 }; mask < 256; ++mask) {
+                auto count = std::size_t{ 0 };
+                for (auto lane = std::size_t{ 0 }; lane < 8; ++lane) {
+                    if (mask & (std::size_t{ 1 } << lane)) {
+                        lut[mask][count++] = static_cast<std::uint8_t>(lane);
+                    }
+                }
+            }
+            return lut;
+        }();
+
+        // the byte shuffle that packs the 32-bit lanes of the set bits of each 4-bit mask to the front
+        inline constexpr auto compress_lut_4 = [] {
+            auto lut = std::array<std::array<std::uint8_t, 16>, 16>{};
+            for (auto mask = std::size_t{ 0 }; mask < 16; ++mask) {
+                auto count = std::size_t{ 0 };
+                for (auto lane = std::size_t{ 0 }; lane < 4; ++lane) {
+                    if (mask & (std::size_t{ 1 } << lane)) {
+                        for (auto byte = std::size_t{ 0 }; byte < 4; ++byte) {
+                            lut[mask][count * 4 + byte] = static_cast<std::uint8_t>(lane * 4 + byte);
+                        }
+                        ++count;
+                    }
+                }
+                for (auto byte = count * 4; byte < 16; ++byte) {
+                    lut[mask][byte] = 0x80;
+                }
+            }
+            return lut;
+        }();
+
+        // SSSE3 doesn't imply POPCNT
+        inline constexpr auto popcount_lut_4 = std::array<std::uint8_t, 16>{
+            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+        };
+
+        template <Cmp C, typename T>
+        __attribute__((target("avx2,popcnt"))) unsigned mask_avx2(__m256i bits, __m256i rhs)
+        {
+            if constexpr (std::same_as<T, float>) {
+                auto lhs = _mm256_castsi256_ps(bits);
+                auto op  = _mm256_castsi256_ps(rhs);
+
+                auto cmp = __m256{};
+                if constexpr (C == Cmp::Less) {
+                    cmp = _mm256_cmp_ps(lhs, op, _CMP_LT_OQ);
+                } else if constexpr (C == Cmp::LessEqual) {
+                    cmp = _mm256_cmp_ps(lhs, op, _CMP_LE_OQ);
+                } else if constexpr (C == Cmp::Greater) {
+                    cmp = _mm256_cmp_ps(lhs, op, _CMP_GT_OQ);
+                } else if constexpr (C == Cmp::GreaterEqual) {
+                    cmp = _mm256_cmp_ps(lhs, op, _CMP_GE_OQ);
+                } else if constexpr (C == Cmp::Equal) {
+                    cmp = _mm256_cmp_ps(lhs, op, _CMP_EQ_OQ);
+                } else {
+                    cmp = _mm256_cmp_ps(lhs, op, _CMP_NEQ_UQ);
+                }
+                return static_cast<unsigned>(_mm256_movemask_ps(cmp));
+            } else {
+                // unsigned values are compared as signed ones with their sign bit flipped
+                if constexpr (std::is_unsigned_v<T> and C != Cmp::AnyBits and C != Cmp::NoBits) {
+                    auto sign = _mm256_set1_epi32(std::numeric_limits<std::int32_t>::min());
+                    bits      = _mm256_xor_si256(bits, sign);
+                    rhs       = _mm256_xor_si256(rhs, sign);
+                }
+
+                auto cmp    = __m256i{};
+                auto invert = false;
+                if constexpr (C == Cmp::Less) {
+                    cmp = _mm256_cmpgt_epi32(rhs, bits);
+                } else if constexpr (C == Cmp::LessEqual) {
+                    cmp    = _mm256_cmpgt_epi32(bits, rhs);
+                    invert = true;
+                } else if constexpr (C == Cmp::Greater) {
+                    cmp = _mm256_cmpgt_epi32(bits, rhs);
+                } else if constexpr (C == Cmp::GreaterEqual) {
+                    cmp    = _mm256_cmpgt_epi32(rhs, bits);
+                    invert = true;
+                } else if constexpr (C == Cmp::Equal) {
+                    cmp = _mm256_cmpeq_epi32(bits, rhs);
+                } else if constexpr (C == Cmp::NotEqual) {
+                    cmp    = _mm256_cmpeq_epi32(bits, rhs);
+                    invert = true;
+                } else if constexpr (C == Cmp::AnyBits) {
+                    cmp    = _mm256_cmpeq_epi32(_mm256_and_si256(bits, rhs), _mm256_setzero_si256());
+                    invert = true;
+                } else {
+                    cmp = _mm256_cmpeq_epi32(_mm256_and_si256(bits, rhs), _mm256_setzero_si256());
+                }
+
+                auto mask = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(cmp)));
+                return invert ? mask ^ 0xffu : mask;
+            }
+        }
+
+        template <Cmp C, typename T>
+        __attribute__((target("ssse3"))) unsigned mask_ssse3(__m128i bits, __m128i rhs)
+        {
+            if constexpr (std::same_as<T, float>) {
+                auto lhs = _mm_castsi128_ps(bits);
+                auto op  = _mm_castsi128_ps(rhs);
+
+                auto cmp = __m128{};
+                if constexpr (C == Cmp::Less) {
+                    cmp = _mm_cmplt_ps(lhs, op);
+                } else if constexpr (C == Cmp::LessEqual) {
+                    cmp = _mm_cmple_ps(lhs, op);
+                } else if constexpr (C == Cmp::Greater) {
+                    cmp = _mm_cmpgt_ps(lhs, op);
+                } else if constexpr (C == Cmp::GreaterEqual) {
+                    cmp = _mm_cmpge_ps(lhs, op);
+                } else if constexpr (C == Cmp::Equal) {
+                    cmp = _mm_cmpeq_ps(lhs, op);
+                } else {
+                    cmp = _mm_cmpneq_ps(lhs, op);
+                }
+                return static_cast<unsigned>(_mm_movemask_ps(cmp));
+            } else {
+                if constexpr (std::is_unsigned_v<T> and C != Cmp::AnyBits and C != Cmp::NoBits) {
+                    auto sign = _mm_set1_epi32(std::numeric_limits<std::int32_t>::min());
+                    bits      = _mm_xor_si128(bits, sign);
+                    rhs       = _mm_xor_si128(rhs, sign);
+                }
+
+                auto cmp    = __m128i{};
+                auto invert = false;
+                if constexpr (C == Cmp::Less) {
+                    cmp = _mm_cmplt_epi32(bits, rhs);
+                } else if constexpr (C == Cmp::LessEqual) {
+                    cmp    = _mm_cmpgt_epi32(bits, rhs);
+                    invert = true;
+                } else if constexpr (C == Cmp::Greater) {
+                    cmp = _mm_cmpgt_epi32(bits, rhs);
+                } else if constexpr (C == Cmp::GreaterEqual) {
+                    cmp    = _mm_cmplt_epi32(bits, rhs);
+                    invert = true;
+                } else if constexpr (C == Cmp::Equal) {
+                    cmp = _mm_cmpeq_epi32(bits, rhs);
+                } else if constexpr (C == Cmp::NotEqual) {
+                    cmp    = _mm_cmpeq_epi32(bits, rhs);
+                    invert = true;
+                } else if constexpr (C == Cmp::AnyBits) {
+                    cmp    = _mm_cmpeq_epi32(_mm_and_si128(bits, rhs), _mm_setzero_si128());
+                    invert = true;
+                } else {
+                    cmp = _mm_cmpeq_epi32(_mm_and_si128(bits, rhs), _mm_setzero_si128());
+                }
+
+                auto mask = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(cmp)));
+                return invert ? mask ^ 0xfu : mask;
+            }
+        }
+
+        template <typename T>
+        std::int32_t lane_bits(T value)
+        {
+            return std::bit_cast<std::int32_t>(value);
+        }
+
+        /**
+         * @brief Filter a block 8 values at a time, the survivors are packed with a lane permutation.
+         *
+         * The input is read and the output is written in whole vectors, both must have room for `n` rounded
+         * up to a multiple of 8.
+         */
+        template <typename T, Cmp C, typename V>
+        __attribute__((target("avx2,popcnt"))) std::size_t filter_avx2(
+            const T* in, std::size_t n, T* out, const Predicate<C, V>& pred
+        )
+        {
+            auto rhs   = _mm256_set1_epi32(lane_bits(static_cast<T>(pred.operand)));
+            auto count = std::size_t{ 0 };
+            for (auto i = std::size_t{ 0 }; i < n; i += 8) {
+                auto bits = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+                auto mask = mask_avx2<C, T>(bits, rhs);
+                if (n - i < 8) {
+                    mask &= (1u << (n - i)) - 1;
+                }
+
+                auto indices = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(compress_lut_8[mask].data()));
+                auto packed  = _mm256_permutevar8x32_epi32(bits, _mm256_cvtepu8_epi32(indices));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + count), packed);
+
+                count += static_cast<std::size_t>(std::popcount(mask));
+            }
+            return count;
+        }
+
+        /**
+         * @brief Filter a block 4 values at a time, the survivors are packed with a byte shuffle.
+         *
+         * The input is read and the output is written in whole vectors, both must have room for `n` rounded
+         * up to a multiple of 4.
+         */
+        template <typename T, Cmp C, typename V>
+        __attribute__((target("ssse3"))) std::size_t filter_ssse3(
+            const T* in, std::size_t n, T* out, const Predicate<C, V>& pred
+        )
+        {
+            auto rhs   = _mm_set1_epi32(lane_bits(static_cast<T>(pred.operand)));
+            auto count = std::size_t{ 0 };
+            for (auto i = std::size_t{ 0 }; i < n; i += 4) {
+                auto bits = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+                auto mask = mask_ssse3<C, T>(bits, rhs);
+                if (n - i < 4) {
+                    mask &= (1u << (n - i)) - 1;
+                }
+
+                auto shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(compress_lut_4[mask].data()));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + count), _mm_shuffle_epi8(bits, shuffle));
+
+                count += popcount_lut_4[mask];
+            }
+            return count;
+        }
+#endif
+
+        /**
+         * @brief Filter a block with the selected instruction set if the predicate is vectorizable.
+         */
+        template <typename T, typename Pred>
+        std::size_t filter_block(const T* in, std::size_t n, T* out, const Pred& pred)
+        {
+#if OPT_ITER_SIMD_X86
+            if constexpr (Vectorizable<T, Pred>) {
+                switch (selected_isa().load(std::memory_order_relaxed)) {
+                case Isa::Avx2: return filter_avx2(in, n, out, pred);
+                case Isa::Ssse3: return filter_ssse3(in, n, out, pred);
+                case Isa::Scalar: break;
+                }
+            }
+#endif
+            return filter_scalar(in, n, out, pred);
+        }
+    }
+
+    /**
+     * @brief The best instruction set supported by the CPU.
+     */
+    inline Isa supported_isa()
+    {
+        return detail::supported_isa();
+    }
+
+    /**
+     * @brief Select the instruction set used by all `simd::Filter`s (e.g. to compare them in a benchmark).
+     *
+     * @return The instruction set actually selected, capped to the supported one.
+     */
+    inline Isa use_isa(Isa isa)
+    {
+        auto selected = std::min(isa, supported_isa());
+        detail::selected_isa().store(selected, std::memory_order_relaxed);
+        return selected;
+    }
+
+    /**
+     * @class Filter
+     *
+     * @brief Yields the values of the parent that satisfy a predicate, evaluated a block at a time.
+     *
+     * @tparam P The type of the parent, an `OptIter` or an input range, can be an lvalue reference to not own it.
+     * @tparam Pred The type of the predicate, see `simd::Predicate` for the vectorizable ones.
+     *
+     * `Filter` is an input range whose iterator walks the packed survivors of the current block, it's also an
+     * `OptIter` (`next()`) and bulk consumers can take the survivors a block at a time with `next_block()`.
+     * The parent is pulled `block_size` values ahead, so the values must not depend on the consumer.
+     */
+    template <typename P, typename Pred>
+    class [[nodiscard]] Filter
+    {
+    private:
+        using Inner = std::remove_reference_t<P>;
+
+        static auto value_type_of()
+        {
+            if constexpr (adapt::Parent<P>) {
+                return std::type_identity<std::remove_cvref_t<adapt::detail::Ret<P>>>{};
+            } else {
+                return std::type_identity<std::ranges::range_value_t<Inner>>{};
+            }
+        }
+
+        // an input range parent is iterated with an iterator created on the first pull
+        static auto iter_type_of()
+        {
+            if constexpr (adapt::Parent<P>) {
+                return std::type_identity<std::tuple<>>{};
+            } else {
+                return std::type_identity<std::optional<std::ranges::iterator_t<Inner>>>{};
+            }
+        }
+
+        struct State;
+
+    public:
+        using Ret = decltype(value_type_of())::type;
+
+        static_assert(std::is_arithmetic_v<Ret>, "The values must be arithmetic.");
+        static_assert(std::predicate<const Pred&, Ret>, "The predicate must accept the values.");
+
+        static constexpr std::size_t block_size = 64;
+
+        class Iterator;
+
+        Filter(P parent, Pred pred)
+            : m_state{ std::make_unique<State>(std::forward<P>(parent), std::move(pred)) }
+        {
+        }
+
+        Inner&       underlying() { return m_state->parent; }
+        const Inner& underlying() const { return m_state->parent; }
+
+        std::optional<Ret> next()
+        {
+            if (not m_state->available()) {
+                return std::nullopt;
+            }
+            return m_state->out[m_state->pos++];
+        }
+
+        /**
+         * @brief Take the remaining survivors of the current block, or of the next non-empty one.
+         *
+         * @return The survivors, valid until the `Filter` is advanced; empty if the parent is exhausted.
+         */
+        std::span<const Ret> next_block()
+        {
+            if (not m_state->available()) {
+                return {};
+            }
+            auto block = std::span<const Ret>{ m_state->out.data() + m_state->pos, m_state->count - m_state->pos };
+            m_state->pos = m_state->count;
+            return block;
+        }
+
+        void reset()
+            requires adapt::Parent<P> and traits::HasReset<Inner>
+        {
+            m_state->parent.reset();
+            m_state->pos   = 0;
+            m_state->count = 0;
+            m_state->done  = false;
+        }
+
+        Iterator begin()
+        {
+            m_state->available();
+            return Iterator{ m_state.get() };
+        }
+
+        std::default_sentinel_t end() const { return {}; }
+
+    private:
+        struct State
+        {
+            // the kernels read and write whole vectors, the slack covers the last partial one
+            static constexpr std::size_t slack = 8;
+
+            State(P parent, Pred pred)
+                : parent{ std::forward<P>(parent) }
+                , pred{ std::move(pred) }
+            {
+            }
+
+            // refill until there is a survivor or the parent is exhausted
+            bool available()
+            {
+                while (pos == count) {
+                    if (done) {
+                        return false;
+                    }
+                    refill();
+                }
+                return true;
+            }
+
+            std::optional<Ret> pull()
+            {
+                if constexpr (adapt::Parent<P>) {
+                    auto value = adapt::detail::pull<P>(parent);
+                    if (not adapt::detail::has_value(value)) {
+                        return std::nullopt;
+                    }
+                    return static_cast<Ret>(adapt::detail::get(value));
+                } else {
+                    if (not iter) {
+                        iter.emplace(std::ranges::begin(parent));
+                    } else {
+                        ++*iter;
+                    }
+                    if (*iter == std::ranges::end(parent)) {
+                        return std::nullopt;
+                    }
+                    return static_cast<Ret>(**iter);
+                }
+            }
+
+            void refill()
+            {
+                auto n = std::size_t{ 0 };
+                while (n < block_size) {
+                    auto value = pull();
+                    if (not value) {
+                        done = true;
+                        break;
+                    }
+                    in[n++] = *value;
+                }
+
+                count = detail::filter_block(in.data(), n, out.data(), pred);
+                pos   = 0;
+            }
+
+            P    parent;
+            Pred pred;
+
+            [[no_unique_address]] decltype(iter_type_of())::type iter = {};
+
+            std::array<Ret, block_size + slack> in    = {};
+            std::array<Ret, block_size + slack> out   = {};
+            std::size_t                         pos   = 0;
+            std::size_t                         count = 0;
+            bool                                done  = false;
+        };
+
+        std::unique_ptr<State> m_state;
+    };
+
+    template <typename P, typename Pred>
+    class [[nodiscard]] Filter<P, Pred>::Iterator
+    {
+    public:
+        using value_type      = Ret;
+        using difference_type = std::ptrdiff_t;
+
+        Iterator() = default;
+
+        explicit Iterator(State* state)
+            : m_state{ state }
+        {
+        }
+
+        [[nodiscard]] const Ret& operator*() const { return m_state->out[m_state->pos]; }
+
+        Iterator& operator++()
+        {
+            ++m_state->pos;
+            m_state->available();
+            return *this;
+        }
+
+        void operator++(int) { ++*this; }
+
+        friend bool operator==(const Iterator& it, std::default_sentinel_t)
+        {
+            return it.m_state->pos == it.m_state->count;
+        }
+
+    private:
+        State* m_state = nullptr;
+    };
+
+    /**
+     * @brief Filter the values of an `OptIter` or an input range a block at a time.
+     *
+     * @param parent The `OptIter` or the input range, referenced if it's an lvalue and owned otherwise.
+     * @param pred The predicate, see `simd::Predicate` for the vectorizable ones.
+     */
+    template <typename P, typename Pred>
+        requires adapt::Parent<P> or std::ranges::input_range<std::remove_reference_t<P>>
+    Filter<P, Pred> filter(P&& parent, Pred pred)
+    {
+        return Filter<P, Pred>{ std::forward<P>(parent), std::move(pred) };
+    }
+}
+
+#endif /* end of include guard: OPT_ITER_SIMD_HPP */
@@ -0,0 +1,265 @@
+#ifndef OPT_ITER_SOA_HPP
+#define OPT_ITER_SOA_HPP
+
+#include "algorithm.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <ranges>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace opt_iter
+{
+    /**
+     * @brief Field descriptors of a struct for `Soa`, given as pointers to data members.
+     *
+     * ```cpp
+     * using Fields = opt_iter::SoaFields<&Val::m_int, &Val::m_float>;
+     * ```
+     */
+    template <auto... Members>
+    struct SoaFields
+    {
+        static_assert(sizeof...(Members) > 0, "At least one member must be given.");
+        static_assert(
+            (std::is_member_object_pointer_v<decltype(Members)> and ...), "The members must be data member pointers."
+        );
+
+        template <typename V>
+        static auto tie(V& value)
+        {
+            return std::tie(value.*Members...);
+        }
+    };
+
+    namespace detail
+    {
+        inline constexpr std::size_t max_aggregate_fields = 8;
+
+        // only used in unevaluated context to count the initializers of an aggregate
+        struct AnyField
+        {
+            template <typename T>
+            operator T() const;
+        };
+
+        template <typename Val, typename... Any>
+        consteval std::size_t aggregate_arity()
+        {
+            if constexpr (sizeof...(Any) > max_aggregate_fields) {
+                return sizeof...(Any);
+            } else if constexpr (requires { Val{ Any{}..., AnyField{} }; }) {
+                return aggregate_arity<Val, Any..., AnyField>();
+            } else {
+                return sizeof...(Any);
+            }
+        }
+
+        template <std::size_t N, typename V>
+        auto tie_aggregate(V& value)
+        {
+            if constexpr (N == 1) {
+                auto& [f0] = value;
+                return std::tie(f0);
+            } else if constexpr (N == 2) {
+                auto& [f0, f1] = value;
+                return std::tie(f0, f1);
+            } else if constexpr (N == 3) {
+                auto& [f0, f1, f2] = value;
+                return std::tie(f0, f1, f2);
+            } else if constexpr (N == 4) {
+                auto& [f0, f1, f2, f3] = value;
+                return std::tie(f0, f1, f2, f3);
+            } else if constexpr (N == 5) {
+                auto& [f0, f1, f2, f3, f4] = value;
+                return std::tie(f0, f1, f2, f3, f4);
+            } else if constexpr (N == 6) {
+                auto& [f0, f1, f2, f3, f4, f5] = value;
+                return std::tie(f0, f1, f2, f3, f4, f5);
+            } else if constexpr (N == 7) {
+                auto& [f0, f1, f2, f3, f4, f5, f6] = value;
+                return std::tie(f0, f1, f2, f3, f4, f5, f6);
+            } else {
+                auto& [f0, f1, f2, f3, f4, f5, f6, f7] = value;
+                return std::tie(f0, f1, f2, f3, f4, f5, f6, f7);
+            }
+        }
+
+        /**
+         * @brief Field descriptors of an aggregate, decomposed with structured bindings.
+         */
+        template <typename Val>
+        struct AggregateFields
+        {
+            static_assert(std::is_aggregate_v<Val>, "Use SoaFields to describe the fields of a non-aggregate.");
+
+            static constexpr std::size_t count = aggregate_arity<Val>();
+
+            static_assert(count > 0, "The aggregate must have at least one field.");
+            static_assert(count <= max_aggregate_fields, "Use SoaFields to describe aggregates with many fields.");
+
+            template <typename V>
+            static auto tie(V& value)
+            {
+                return tie_aggregate<count>(value);
+            }
+        };
+
+        template <typename Tie>
+        struct SoaColumns;
+
+        template <typename... Refs>
+        struct SoaColumns<std::tuple<Refs...>>
+        {
+            using Type = std::tuple<std::vector<std::remove_cvref_t<Refs>>...>;
+        };
+
+        template <typename Member>
+        struct MemberClass;
+
+        template <typename C, typename T>
+        struct MemberClass<T C::*>
+        {
+            using Type = C;
+        };
+
+        // the number of values to reserve if the range knows its size
+        template <typename Rng>
+        std::size_t size_hint(Rng& range)
+        {
+            if constexpr (StaticSizedRange<Rng>) {
+                return static_size_v<Rng>;
+            } else if constexpr (std::ranges::sized_range<Rng>) {
+                return static_cast<std::size_t>(std::ranges::size(range));
+            } else {
+                return 0;
+            }
+        }
+    }
+
+    /**
+     * @class Soa
+     *
+     * @brief Struct-of-arrays container: each field of `Val` is stored in its own contiguous column.
+     *
+     * @tparam Val The type of the struct.
+     * @tparam Fields The field descriptors, an aggregate is decomposed with structured bindings by default (up to
+     * 8 fields, C arrays and bit-fields are not supported). Use `SoaFields` for other types.
+     *
+     * Kernels that work on a single field iterate its column (`column<I>()`) directly instead of striding over
+     * the whole structs or transposing them first.
+     */
+    template <typename Val, typename Fields = detail::AggregateFields<Val>>
+    class [[nodiscard]] Soa
+    {
+    private:
+        using Tie = decltype(Fields::tie(std::declval<Val&>()));
+
+    public:
+        static constexpr std::size_t field_count = std::tuple_size_v<Tie>;
+
+        template <std::size_t I>
+        using Field = std::remove_cvref_t<std::tuple_element_t<I, Tie>>;
+
+        std::size_t size() const { return std::get<0>(m_columns).size(); }
+        bool        empty() const { return size() == 0; }
+
+        void reserve(std::size_t n)
+        {
+            std::apply([&](auto&... columns) { (columns.reserve(n), ...); }, m_columns);
+        }
+
+        /**
+         * @brief Scatter the fields of the value into the columns.
+         */
+        void push_back(const Val& value) { scatter<false>(Fields::tie(value)); }
+        void push_back(Val&& value) { scatter<true>(Fields::tie(value)); }
+
+        template <std::size_t I>
+        std::span<Field<I>> column()
+        {
+            return std::get<I>(m_columns);
+        }
+
+        template <std::size_t I>
+        std::span<const Field<I>> column() const
+        {
+            return std::get<I>(m_columns);
+        }
+
+    private:
+        template <bool Move, typename Refs>
+        void scatter(Refs refs)
+        {
+            [&]<std::size_t... I>(std::index_sequence<I...>) {
+                if constexpr (Move) {
+                    (std::get<I>(m_columns).push_back(std::move(std::get<I>(refs))), ...);
+                } else {
+                    (std::get<I>(m_columns).push_back(std::get<I>(refs)), ...);
+                }
+            }(std::make_index_sequence<field_count>{});
+        }
+
+        typename detail::SoaColumns<Tie>::Type m_columns;
+    };
+
+    namespace detail
+    {
+        template <typename Out, typename Rng>
+        Out collect_soa(Rng&& range)
+        {
+            auto soa  = Out{};
+            auto push = [&](auto&& value) { soa.push_back(std::forward<decltype(value)>(value)); };
+
+            soa.reserve(size_hint(range));
+            opt_iter::for_each(std::forward<Rng>(range), push);
+            return soa;
+        }
+    }
+
+    /**
+     * @brief Collect the values of a range into struct-of-arrays layout, decomposing the aggregate `Val`.
+     *
+     * The columns are reserved up front if the size of the range is known (see `StaticSizedRange` and
+     * `std::ranges::sized_range`).
+     *
+     * ```cpp
+     * auto soa    = opt_iter::collect_soa<Val>(opt_iter::make_owned<RandGen>(rng, count));
+     * auto floats = soa.column<1>();       // std::span<float>
+     * ```
+     *
+     * @param range The range to collect.
+     */
+    template <typename Val, std::ranges::input_range Rng>
+        requires std::convertible_to<std::ranges::range_reference_t<Rng>, Val>
+    Soa<Val> collect_soa(Rng&& range)
+    {
+        return detail::collect_soa<Soa<Val>>(std::forward<Rng>(range));
+    }
+
+    /**
+     * @brief Collect the values of a range into struct-of-arrays layout, one column for each of the members.
+     *
+     * ```cpp
+     * auto soa = opt_iter::collect_soa<&Val::m_float, &Val::m_int>(range);
+     * ```
+     *
+     * @param range The range to collect.
+     */
+    template <auto Member, auto... Members, std::ranges::input_range Rng>
+        requires std::is_member_object_pointer_v<decltype(Member)>
+    auto collect_soa(Rng&& range)
+    {
+        using Val = detail::MemberClass<decltype(Member)>::Type;
+        using Out = Soa<Val, SoaFields<Member, Members...>>;
+
+        static_assert(std::convertible_to<std::ranges::range_reference_t<Rng>, Val>, "The values must be Val.");
+        return detail::collect_soa<Out>(std::forward<Rng>(range));
+    }
+}
+
+#endif /* end of include guard: OPT_ITER_SOA_HPP */
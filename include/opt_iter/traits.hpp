@@ -1,11 +1,32 @@
 #ifndef OPT_ITER_TRAITS_HPP
 #define OPT_ITER_TRAITS_HPP
 
+#include <concepts>
+#include <cstddef>
 #include <optional>
+#include <span>
 #include <type_traits>
 
+#if __has_include(<expected>)
+#    include <expected>
+#endif
+
 namespace opt_iter::traits
 {
+    /**
+     * @brief Customization point for optional-like types.
+     *
+     * Specialize this for an optional-like type (e.g. `tl::optional`, `boost::optional`, or an in-house
+     * compact optional) to allow it to be returned from `next()`/`operator()()` and stored directly by the
+     * range wrappers. The specialization must derive from `std::true_type` and provide:
+     *
+     * - `Type`: the contained type,
+     * - `static bool has_value(const O&)`: whether the optional contains a value,
+     * - `static Type& get(O&)`: access the contained value (only called when `has_value()` is true), and
+     * - `static void reset(O&)`: make the optional empty.
+     *
+     * A value-initialized optional-like type must be empty.
+     */
     template <typename>
     struct OptTrait : std::false_type
     {
@@ -15,20 +36,144 @@ namespace opt_iter::traits
     struct OptTrait<std::optional<T>> : std::true_type
     {
         using Type = T;
+
+        static constexpr bool has_value(const std::optional<T>& opt) noexcept { return opt.has_value(); }
+        static constexpr T&   get(std::optional<T>& opt) noexcept { return *opt; }
+        static constexpr void reset(std::optional<T>& opt) noexcept { opt.reset(); }
+    };
+
+    /**
+     * @brief Storage for iterables that refill the value in place through `bool next(R& out)`.
+     *
+     * Unlike `std::optional`, resetting it only marks it empty, the value itself is kept alive so the
+     * resources it holds (e.g. the capacity of a `std::string`) can be reused by the next refill.
+     */
+    template <typename T>
+    struct RefillOpt
+    {
+        T    value   = {};
+        bool engaged = false;
+    };
+
+    template <typename T>
+    struct OptTrait<RefillOpt<T>> : std::true_type
+    {
+        using Type = T;
+
+        static constexpr bool has_value(const RefillOpt<T>& opt) noexcept { return opt.engaged; }
+        static constexpr T&   get(RefillOpt<T>& opt) noexcept { return opt.value; }
+        static constexpr void reset(RefillOpt<T>& opt) noexcept { opt.engaged = false; }
+    };
+
+    template <typename O>
+    concept OptLike = OptTrait<O>::value and std::default_initializable<O> and std::movable<O>
+                  and requires (O& opt, const O& copt) {
+                          { OptTrait<O>::has_value(copt) } -> std::convertible_to<bool>;
+                          { OptTrait<O>::get(opt) } -> std::same_as<typename OptTrait<O>::Type&>;
+                          { OptTrait<O>::reset(opt) };
+                      };
+
+    template <typename>
+    struct ExpectedTrait : std::false_type
+    {
+    };
+
+#if defined(__cpp_lib_expected)
+    template <OptLike O, typename E>
+    struct ExpectedTrait<std::expected<O, E>> : std::true_type
+    {
+        using Opt   = O;
+        using Type  = OptTrait<O>::Type;
+        using Error = E;
     };
+#endif
 
     template <typename T>
     concept HasNext = requires (T t) {
         { t.next() };
-        requires OptTrait<std::invoke_result_t<decltype(&T::next), T>>::value;
+        requires OptLike<std::invoke_result_t<decltype(&T::next), T>>;
     };
 
     template <typename T>
     concept HasCallOp = requires (T t) {
         { t() };
-        requires OptTrait<std::invoke_result_t<T>>::value;
+        requires OptLike<std::invoke_result_t<T>>;
+    };
+
+    // next() that reports failure through std::expected<std::optional<R>, E> instead of throwing
+    template <typename T>
+    concept HasTryNext = requires (T t) {
+        { t.next() };
+        requires ExpectedTrait<std::invoke_result_t<decltype(&T::next), T>>::value;
     };
 
+    template <typename>
+    struct NextIntoTrait : std::false_type
+    {
+    };
+
+    template <typename C, typename T>
+    struct NextIntoTrait<bool (C::*)(T&)> : std::true_type
+    {
+        using Type = T;
+    };
+
+    template <typename C, typename T>
+    struct NextIntoTrait<bool (C::*)(T&) noexcept> : std::true_type
+    {
+        using Type = T;
+    };
+
+    // next() that refills an existing value in place instead of returning a new one: `bool next(R& out)`
+    template <typename T>
+    concept HasNextInto = requires {
+        { &T::next };
+        requires NextIntoTrait<decltype(&T::next)>::value;
+        requires std::default_initializable<typename NextIntoTrait<decltype(&T::next)>::Type>;
+    };
+
+    template <typename T>
+    concept HasNextLike = HasNext<T> or HasNextInto<T>;
+
+    // next_back() that takes the values from the other end, next() and next_back() must meet in the middle
+    template <typename T>
+    concept HasNextBack = HasNext<T> and requires (T t) {
+        { t.next_back() } -> std::same_as<std::invoke_result_t<decltype(&T::next), T>>;
+    };
+
+    // reset() that restarts the iteration from the beginning
+    template <typename T>
+    concept HasReset = requires (T t) { t.reset(); };
+
+    // skip(n) that drops the next n values without generating them, returns the number of values skipped
+    template <typename T>
+    concept HasSkip = requires (T t, std::size_t n) {
+        { t.skip(n) } -> std::convertible_to<std::size_t>;
+    };
+
+    // number of values known at compile time: `using static_size = std::integral_constant<std::size_t, N>`
+    template <typename T>
+    concept HasStaticSize = requires {
+        typename T::static_size;
+        requires std::derived_from<typename T::static_size, std::integral_constant<std::size_t, T::static_size::value>>;
+    };
+
+    template <typename>
+    struct SpanTrait : std::false_type
+    {
+    };
+
+    template <typename T, std::size_t Extent>
+    struct SpanTrait<std::span<T, Extent>> : std::true_type
+    {
+        using Type = std::remove_cv_t<T>;
+    };
+
+    // next() that yields a contiguous block of values per call instead of a single value
+    template <typename T>
+    concept HasSpanNext = HasNext<T>
+                      and SpanTrait<typename OptTrait<std::invoke_result_t<decltype(&T::next), T>>::Type>::value;
+
     template <typename>
     struct OptIterTrait : std::false_type
     {
@@ -39,14 +184,33 @@ namespace opt_iter::traits
         requires (HasNext<T> and not HasCallOp<T>)
     struct OptIterTrait<T>
     {
-        using Ret = OptTrait<std::invoke_result_t<decltype(&T::next), T>>::Type;
+        using Opt = std::invoke_result_t<decltype(&T::next), T>;
+        using Ret = OptTrait<Opt>::Type;
+    };
+
+    template <typename T>
+        requires HasTryNext<T>
+    struct OptIterTrait<T>
+    {
+        using Opt   = ExpectedTrait<std::invoke_result_t<decltype(&T::next), T>>::Opt;
+        using Ret   = ExpectedTrait<std::invoke_result_t<decltype(&T::next), T>>::Type;
+        using Error = ExpectedTrait<std::invoke_result_t<decltype(&T::next), T>>::Error;
+    };
+
+    template <typename T>
+        requires HasNextInto<T>
+    struct OptIterTrait<T>
+    {
+        using Ret = NextIntoTrait<decltype(&T::next)>::Type;
+        using Opt = RefillOpt<Ret>;
     };
 
     template <typename T>
-        requires (HasCallOp<T> and not HasNext<T>)
+        requires (HasCallOp<T> and not HasNext<T> and not HasTryNext<T> and not HasNextInto<T>)
     struct OptIterTrait<T>
     {
-        using Ret = OptTrait<std::invoke_result_t<T>>::Type;
+        using Opt = std::invoke_result_t<T>;
+        using Ret = OptTrait<Opt>::Type;
     };
 
     // allow type that has both next() and operator()()
@@ -54,7 +218,8 @@ namespace opt_iter::traits
         requires HasNext<T> and HasCallOp<T>
     struct OptIterTrait<T> : std::true_type
     {
-        using Ret = OptTrait<std::invoke_result_t<decltype(&T::next), T>>::Type;
+        using Opt = std::invoke_result_t<decltype(&T::next), T>;
+        using Ret = OptTrait<Opt>::Type;
     };
 }
 
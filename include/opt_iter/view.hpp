@@ -0,0 +1,759 @@
+#ifndef OPT_ITER_VIEW_HPP
+#define OPT_ITER_VIEW_HPP
+
+#include "traits.hpp"
+
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+/**
+ * Views for input ranges (e.g. the ranges of opt_iter) that the standard views reject because they require
+ * a forward range. They keep a constant amount of state regardless of the length of the range.
+ */
+namespace opt_iter
+{
+    /**
+     * @class GroupBy
+     *
+     * @brief Groups consecutive values of an input range that have the same key.
+     *
+     * @tparam Rng The type of the range, can be an lvalue reference to not own the range.
+     * @tparam KeyFn The type of the function that computes the key of a value.
+     *
+     * Each group is a lazily consumed sub-range that shares a single slot for the current value with the
+     * parent, nothing is materialized. Advancing to the next group skips the unconsumed remainder of the
+     * current group. The state is kept in the heap so that the groups stay valid when the view is moved.
+     */
+    template <typename Rng, typename KeyFn>
+        requires std::ranges::input_range<std::remove_cvref_t<Rng>>
+    class [[nodiscard]] GroupBy
+    {
+    public:
+        using Inner = std::remove_reference_t<Rng>;
+        using Ref   = std::ranges::range_reference_t<Inner>;
+        using Value = std::ranges::range_value_t<Inner>;
+        using Key   = std::remove_cvref_t<std::invoke_result_t<KeyFn&, const Value&>>;
+
+        static_assert(std::equality_comparable<Key>, "The key must be equality comparable.");
+
+        class Group;
+        class GroupIterator;
+        class Iterator;
+
+        GroupBy(Rng range, KeyFn key_fn)
+            : m_state{ std::make_unique<State>(std::forward<Rng>(range), std::move(key_fn)) }
+        {
+        }
+
+        Inner&       underlying() { return m_state->range; }
+        const Inner& underlying() const { return m_state->range; }
+
+        Iterator begin()
+        {
+            m_state->it.emplace(std::ranges::begin(m_state->range));
+            m_state->load();
+            m_state->key = m_state->slot_key;
+            return Iterator{ m_state.get() };
+        }
+
+        std::default_sentinel_t end() const { return {}; }
+
+    private:
+        // a value held by the parent as lvalue (e.g. refilled in place) is referenced instead of moved
+        static constexpr bool by_ref = std::is_lvalue_reference_v<Ref>;
+
+        using Slot    = std::conditional_t<by_ref, std::remove_reference_t<Ref>*, std::optional<Value>>;
+        using SlotRef = std::conditional_t<by_ref, Ref, Value&>;
+
+        struct State
+        {
+            State(Rng range, KeyFn key_fn)
+                : range{ std::forward<Rng>(range) }
+                , key_fn{ std::move(key_fn) }
+            {
+            }
+
+            bool has_value() const { return static_cast<bool>(slot); }
+
+            auto& value()
+            {
+                assert(has_value());
+                return *slot;
+            }
+
+            void load()
+            {
+                if (*it == std::ranges::end(range)) {
+                    slot = Slot{};
+                    return;
+                }
+                if constexpr (by_ref) {
+                    slot = std::addressof(**it);
+                } else {
+                    slot.emplace(**it);
+                }
+                slot_key.emplace(std::invoke(key_fn, std::as_const(value())));
+            }
+
+            void advance()
+            {
+                ++*it;
+                load();
+            }
+
+            bool in_group() const { return has_value() and *slot_key == *key; }
+
+            Rng   range;
+            KeyFn key_fn;
+
+            std::optional<std::ranges::iterator_t<Inner>> it       = std::nullopt;
+            Slot                                          slot     = {};
+            std::optional<Key>                            slot_key = std::nullopt;
+            std::optional<Key>                            key      = std::nullopt;
+        };
+
+        std::unique_ptr<State> m_state;
+    };
+
+    /**
+     * @brief Iterates the values of the current group, shares the slot with the parent.
+     */
+    template <typename Rng, typename KeyFn>
+        requires std::ranges::input_range<std::remove_cvref_t<Rng>>
+    class [[nodiscard]] GroupBy<Rng, KeyFn>::GroupIterator
+    {
+    public:
+        using value_type      = Value;
+        using difference_type = std::ptrdiff_t;
+
+        GroupIterator() = default;
+
+        explicit GroupIterator(State* state)
+            : m_state{ state }
+        {
+        }
+
+        [[nodiscard]] SlotRef operator*() const { return m_state->value(); }
+
+        GroupIterator& operator++()
+        {
+            m_state->advance();
+            return *this;
+        }
+
+        void operator++(int) { ++*this; }
+
+        friend bool operator==(const GroupIterator& it, std::default_sentinel_t)
+        {
+            return not it.m_state->in_group();
+        }
+
+    private:
+        State* m_state = nullptr;
+    };
+
+    /**
+     * @brief A group of consecutive values with the same key, valid until the parent is advanced.
+     */
+    template <typename Rng, typename KeyFn>
+        requires std::ranges::input_range<std::remove_cvref_t<Rng>>
+    class [[nodiscard]] GroupBy<Rng, KeyFn>::Group
+    {
+    public:
+        explicit Group(State* state)
+            : m_state{ state }
+        {
+        }
+
+        const Key& key() const { return *m_state->key; }
+
+        GroupIterator           begin() const { return GroupIterator{ m_state }; }
+        std::default_sentinel_t end() const { return {}; }
+
+    private:
+        State* m_state;
+    };
+
+    template <typename Rng, typename KeyFn>
+        requires std::ranges::input_range<std::remove_cvref_t<Rng>>
+    class [[nodiscard]] GroupBy<Rng, KeyFn>::Iterator
+    {
+    public:
+        using value_type      = Group;
+        using difference_type = std::ptrdiff_t;
+
+        Iterator() = default;
+
+        explicit Iterator(State* state)
+            : m_state{ state }
+        {
+        }
+
+        [[nodiscard]] Group operator*() const { return Group{ m_state }; }
+
+        // skips the unconsumed remainder of the current group
+        Iterator& operator++()
+        {
+            while (m_state->in_group()) {
+                m_state->advance();
+            }
+            m_state->key = m_state->slot_key;
+            return *this;
+        }
+
+        void operator++(int) { ++*this; }
+
+        friend bool operator==(const Iterator& it, std::default_sentinel_t) { return not it.m_state->has_value(); }
+
+    private:
+        State* m_state = nullptr;
+    };
+
+    /**
+     * @brief Group consecutive values of an input range that have the same key.
+     *
+     * @param range The range to group, referenced if it's an lvalue and owned otherwise.
+     * @param key_fn The function that computes the key of a value.
+     */
+    template <std::ranges::input_range Rng, typename KeyFn>
+    GroupBy<Rng, KeyFn> group_by(Rng&& range, KeyFn key_fn)
+    {
+        return GroupBy<Rng, KeyFn>{ std::forward<Rng>(range), std::move(key_fn) };
+    }
+
+    /**
+     * @class Windows
+     *
+     * @brief Yields overlapping windows of `N` consecutive values of an input range as contiguous spans.
+     *
+     * @tparam Rng The type of the range, can be an lvalue reference to not own the range.
+     * @tparam N The size of the window, `std::dynamic_extent` if it's only known at runtime.
+     *
+     * The last `N` values are kept in a mirrored ring buffer of size `2N`: each value is written at its
+     * position in the ring and again `N` elements later, so the window starting at any position of the ring
+     * is contiguous. The buffer is allocated once (together with the rest of the state for compile-time
+     * `N`), nothing is allocated per window. A span is valid until the view is advanced. If the range has
+     * less than `N` values, there are no windows.
+     */
+    template <typename Rng, std::size_t N = std::dynamic_extent>
+        requires std::ranges::input_range<std::remove_cvref_t<Rng>>
+    class [[nodiscard]] Windows
+    {
+    public:
+        using Inner  = std::remove_reference_t<Rng>;
+        using Value  = std::ranges::range_value_t<Inner>;
+        using Window = std::span<const Value, N>;
+
+        static_assert(std::default_initializable<Value>, "The values must be default initializable.");
+
+        class Iterator;
+
+        Windows(Rng range)
+            requires (N != std::dynamic_extent and N > 0)
+            : m_state{ std::make_unique<State>(std::forward<Rng>(range), N) }
+        {
+        }
+
+        Windows(Rng range, std::size_t size)
+            requires (N == std::dynamic_extent)
+            : m_state{ std::make_unique<State>(std::forward<Rng>(range), size) }
+        {
+            assert(size > 0);
+        }
+
+        Inner&       underlying() { return m_state->range; }
+        const Inner& underlying() const { return m_state->range; }
+
+        Iterator begin()
+        {
+            m_state->start();
+            return Iterator{ m_state.get() };
+        }
+
+        std::default_sentinel_t end() const { return {}; }
+
+    private:
+        using Buffer = std::conditional_t<
+            N == std::dynamic_extent,
+            std::unique_ptr<Value[]>,
+            std::array<Value, N == std::dynamic_extent ? 0 : 2 * N>>;
+
+        struct State
+        {
+            State(Rng range, std::size_t size)
+                : range{ std::forward<Rng>(range) }
+                , size{ size }
+            {
+                if constexpr (N == std::dynamic_extent) {
+                    buffer = std::make_unique<Value[]>(2 * size);
+                }
+            }
+
+            void start()
+            {
+                it.emplace(std::ranges::begin(range));
+                started = false;
+                pos     = 0;
+                done    = false;
+
+                for (auto i = std::size_t{ 0 }; i < size and not done; ++i) {
+                    push();
+                }
+            }
+
+            // the parent is only advanced when the next value is needed
+            void push()
+            {
+                if (started) {
+                    ++*it;
+                }
+                started = true;
+
+                if (*it == std::ranges::end(range)) {
+                    done = true;
+                    return;
+                }
+
+                buffer[pos]        = **it;
+                buffer[pos + size] = buffer[pos];
+                pos                = pos + 1 == size ? 0 : pos + 1;
+            }
+
+            Window window() const { return Window{ &buffer[pos], size }; }
+
+            Rng         range;
+            std::size_t size;
+            Buffer      buffer = {};
+
+            std::optional<std::ranges::iterator_t<Inner>> it      = std::nullopt;
+            std::size_t                                   pos     = 0;
+            bool                                          started = false;
+            bool                                          done    = true;
+        };
+
+        std::unique_ptr<State> m_state;
+    };
+
+    template <typename Rng, std::size_t N>
+        requires std::ranges::input_range<std::remove_cvref_t<Rng>>
+    class [[nodiscard]] Windows<Rng, N>::Iterator
+    {
+    public:
+        using value_type      = Window;
+        using difference_type = std::ptrdiff_t;
+
+        Iterator() = default;
+
+        explicit Iterator(State* state)
+            : m_state{ state }
+        {
+        }
+
+        [[nodiscard]] Window operator*() const { return m_state->window(); }
+
+        Iterator& operator++()
+        {
+            m_state->push();
+            return *this;
+        }
+
+        void operator++(int) { ++*this; }
+
+        friend bool operator==(const Iterator& it, std::default_sentinel_t) { return it.m_state->done; }
+
+    private:
+        State* m_state = nullptr;
+    };
+
+    /**
+     * @brief Sliding windows of `N` consecutive values of an input range, `N` known at compile time.
+     *
+     * `windows<2>` yields the adjacent pairs.
+     *
+     * @param range The range to iterate, referenced if it's an lvalue and owned otherwise.
+     */
+    template <std::size_t N, std::ranges::input_range Rng>
+        requires (N > 0)
+    Windows<Rng, N> windows(Rng&& range)
+    {
+        return Windows<Rng, N>{ std::forward<Rng>(range) };
+    }
+
+    /**
+     * @brief Sliding windows of `size` consecutive values of an input range.
+     *
+     * @param range The range to iterate, referenced if it's an lvalue and owned otherwise.
+     * @param size The size of the window, must be greater than 0.
+     */
+    template <std::ranges::input_range Rng>
+    Windows<Rng> windows(Rng&& range, std::size_t size)
+    {
+        return Windows<Rng>{ std::forward<Rng>(range), size };
+    }
+
+    /**
+     * @class Flatten
+     *
+     * @brief Yields the values of the inner ranges or inner `OptIter`s produced by an input range.
+     *
+     * @tparam Rng The type of the range, can be an lvalue reference to not own the range.
+     * @tparam Fn The function that turns a value of the range into the inner range or `OptIter`.
+     *
+     * Exactly one inner value is held at a time in a single slot and iterated in place, an inner value held
+     * by the parent as lvalue (e.g. refilled in place) is referenced instead of moved. An inner `OptIter`
+     * has its values pulled into a single storage, so nothing is allocated per inner `OptIter`.
+     */
+    template <typename Rng, typename Fn = std::identity>
+        requires std::ranges::input_range<std::remove_cvref_t<Rng>>
+    class [[nodiscard]] Flatten
+    {
+    public:
+        using Outer    = std::remove_reference_t<Rng>;
+        using InnerRef = std::invoke_result_t<Fn&, std::ranges::range_reference_t<Outer>>;
+        using Inner    = std::remove_cvref_t<InnerRef>;
+
+        static constexpr bool inner_range = std::ranges::input_range<Inner>;
+
+        static_assert(
+            inner_range or traits::HasNext<Inner> or traits::HasCallOp<Inner>,
+            "The inner value must be an input range or an OptIter."
+        );
+
+        class Iterator;
+
+        Flatten(Rng range, Fn fn = {})
+            : m_state{ std::make_unique<State>(std::forward<Rng>(range), std::move(fn)) }
+        {
+        }
+
+        Outer&       underlying() { return m_state->range; }
+        const Outer& underlying() const { return m_state->range; }
+
+        Iterator begin()
+        {
+            m_state->start();
+            return Iterator{ m_state.get() };
+        }
+
+        std::default_sentinel_t end() const { return {}; }
+
+    private:
+        static constexpr bool by_ref = std::is_lvalue_reference_v<InnerRef>;
+
+        using Slot = std::conditional_t<by_ref, std::remove_reference_t<InnerRef>*, std::optional<Inner>>;
+
+        struct RangeCursor
+        {
+            using Ref = std::ranges::range_reference_t<std::remove_reference_t<InnerRef>>;
+
+            std::optional<std::ranges::iterator_t<std::remove_reference_t<InnerRef>>> it = std::nullopt;
+        };
+
+        struct OptIterCursor
+        {
+            using Opt = traits::OptIterTrait<Inner>::Opt;
+            using Ref = traits::OptIterTrait<Inner>::Ret&;
+
+            Opt value = {};
+        };
+
+        using Cursor = std::conditional_t<inner_range, RangeCursor, OptIterCursor>;
+
+        struct State
+        {
+            State(Rng range, Fn fn)
+                : range{ std::forward<Rng>(range) }
+                , fn{ std::move(fn) }
+            {
+            }
+
+            void start()
+            {
+                outer.emplace(std::ranges::begin(range));
+                started = false;
+                done    = false;
+                inner   = Slot{};
+                find_value();
+            }
+
+            typename Cursor::Ref value()
+            {
+                if constexpr (inner_range) {
+                    return **cursor.it;
+                } else {
+                    return traits::OptTrait<typename Cursor::Opt>::get(cursor.value);
+                }
+            }
+
+            void advance()
+            {
+                if constexpr (inner_range) {
+                    ++*cursor.it;
+                }
+                find_value();
+            }
+
+            // pulls the next inner value, moving to the next inner range or OptIter when one is exhausted
+            void find_value()
+            {
+                while (true) {
+                    if (inner and inner_has_value()) {
+                        return;
+                    }
+
+                    if (started) {
+                        ++*outer;
+                    }
+                    started = true;
+
+                    if (*outer == std::ranges::end(range)) {
+                        done = true;
+                        return;
+                    }
+                    load();
+                }
+            }
+
+            bool inner_has_value()
+            {
+                if constexpr (inner_range) {
+                    return *cursor.it != std::ranges::end(*inner);
+                } else {
+                    using Opt = Cursor::Opt;
+                    if constexpr (traits::HasNext<Inner>) {
+                        cursor.value = inner->next();
+                    } else {
+                        cursor.value = (*inner)();
+                    }
+                    return traits::OptTrait<Opt>::has_value(cursor.value);
+                }
+            }
+
+            void load()
+            {
+                if constexpr (by_ref) {
+                    inner = std::addressof(std::invoke(fn, **outer));
+                } else {
+                    inner.emplace(std::invoke(fn, **outer));
+                }
+                if constexpr (inner_range) {
+                    cursor.it.emplace(std::ranges::begin(*inner));
+                }
+            }
+
+            Rng range;
+            Fn  fn;
+
+            std::optional<std::ranges::iterator_t<Outer>> outer   = std::nullopt;
+            Slot                                           inner   = {};
+            Cursor                                         cursor  = {};
+            bool                                           started = false;
+            bool                                           done    = true;
+        };
+
+        std::unique_ptr<State> m_state;
+    };
+
+    template <typename Rng, typename Fn>
+        requires std::ranges::input_range<std::remove_cvref_t<Rng>>
+    class [[nodiscard]] Flatten<Rng, Fn>::Iterator
+    {
+    public:
+        using Ref             = Cursor::Ref;
+        using value_type      = std::remove_cvref_t<Ref>;
+        using difference_type = std::ptrdiff_t;
+
+        Iterator() = default;
+
+        explicit Iterator(State* state)
+            : m_state{ state }
+        {
+        }
+
+        [[nodiscard]] Ref operator*() const { return m_state->value(); }
+
+        Iterator& operator++()
+        {
+            m_state->advance();
+            return *this;
+        }
+
+        void operator++(int) { ++*this; }
+
+        friend bool operator==(const Iterator& it, std::default_sentinel_t) { return it.m_state->done; }
+
+    private:
+        State* m_state = nullptr;
+    };
+
+    /**
+     * @brief Flatten an input range of ranges or `OptIter`s.
+     *
+     * @param range The range to flatten, referenced if it's an lvalue and owned otherwise.
+     */
+    template <std::ranges::input_range Rng>
+    Flatten<Rng> flatten(Rng&& range)
+    {
+        return Flatten<Rng>{ std::forward<Rng>(range) };
+    }
+
+    /**
+     * @brief Map each value of an input range into a range or an `OptIter` and flatten the result.
+     *
+     * @param range The range to iterate, referenced if it's an lvalue and owned otherwise.
+     * @param fn The function that turns a value into a range or an `OptIter`.
+     */
+    template <std::ranges::input_range Rng, typename Fn>
+    Flatten<Rng, Fn> flat_map(Rng&& range, Fn fn)
+    {
+        return Flatten<Rng, Fn>{ std::forward<Rng>(range), std::move(fn) };
+    }
+
+    /**
+     * @class Chunks
+     *
+     * @brief Yields non-overlapping chunks of `n` consecutive values of an input range as contiguous spans.
+     *
+     * @tparam Rng The type of the range, can be an lvalue reference to not own the range.
+     *
+     * The values are moved into a buffer of size `n` that is allocated once and reused for every chunk, the
+     * last chunk might be shorter. A span is valid until the view is advanced. The values referenced by the
+     * range are copied instead, and the spans are read-only if the range yields them as const.
+     */
+    template <typename Rng>
+        requires std::ranges::input_range<std::remove_cvref_t<Rng>>
+    class [[nodiscard]] Chunks
+    {
+    public:
+        using Inner = std::remove_reference_t<Rng>;
+        using Ref   = std::ranges::range_reference_t<Inner>;
+        using Value = std::ranges::range_value_t<Inner>;
+        using Chunk = std::span<std::conditional_t<std::is_const_v<std::remove_reference_t<Ref>>, const Value, Value>>;
+
+        static_assert(std::default_initializable<Value>, "The values must be default initializable.");
+
+        class Iterator;
+
+        Chunks(Rng range, std::size_t size)
+            : m_state{ std::make_unique<State>(std::forward<Rng>(range), size) }
+        {
+            assert(size > 0);
+        }
+
+        Inner&       underlying() { return m_state->range; }
+        const Inner& underlying() const { return m_state->range; }
+
+        Iterator begin()
+        {
+            m_state->start();
+            return Iterator{ m_state.get() };
+        }
+
+        std::default_sentinel_t end() const { return {}; }
+
+    private:
+        struct State
+        {
+            State(Rng range, std::size_t size)
+                : range{ std::forward<Rng>(range) }
+                , size{ size }
+                , buffer{ std::make_unique<Value[]>(size) }
+            {
+            }
+
+            void start()
+            {
+                it.emplace(std::ranges::begin(range));
+                started = false;
+                done    = false;
+                fill();
+            }
+
+            // the parent is only advanced when the next value is needed, and never past its end
+            void fill()
+            {
+                count = 0;
+                while (count < size and not done) {
+                    if (started) {
+                        ++*it;
+                    }
+                    started = true;
+
+                    if (*it == std::ranges::end(range)) {
+                        done = true;
+                        break;
+                    }
+                    buffer[count++] = **it;
+                }
+            }
+
+            Chunk chunk() const { return Chunk{ buffer.get(), count }; }
+
+            Rng                      range;
+            std::size_t              size;
+            std::unique_ptr<Value[]> buffer;
+
+            std::optional<std::ranges::iterator_t<Inner>> it      = std::nullopt;
+            std::size_t                                   count   = 0;
+            bool                                          started = false;
+            bool                                          done    = true;
+        };
+
+        std::unique_ptr<State> m_state;
+    };
+
+    template <typename Rng>
+        requires std::ranges::input_range<std::remove_cvref_t<Rng>>
+    class [[nodiscard]] Chunks<Rng>::Iterator
+    {
+    public:
+        using value_type      = Chunk;
+        using difference_type = std::ptrdiff_t;
+
+        Iterator() = default;
+
+        explicit Iterator(State* state)
+            : m_state{ state }
+        {
+        }
+
+        [[nodiscard]] Chunk operator*() const { return m_state->chunk(); }
+
+        Iterator& operator++()
+        {
+            m_state->fill();
+            return *this;
+        }
+
+        void operator++(int) { ++*this; }
+
+        friend bool operator==(const Iterator& it, std::default_sentinel_t) { return it.m_state->count == 0; }
+
+    private:
+        State* m_state = nullptr;
+    };
+
+    /**
+     * @brief Non-overlapping chunks of `size` consecutive values of an input range.
+     *
+     * @param range The range to iterate, referenced if it's an lvalue and owned otherwise.
+     * @param size The size of the chunk, must be greater than 0.
+     */
+    template <std::ranges::input_range Rng>
+    Chunks<Rng> chunks(Rng&& range, std::size_t size)
+    {
+        return Chunks<Rng>{ std::forward<Rng>(range), size };
+    }
+}
+
+#endif /* end of include guard: OPT_ITER_VIEW_HPP */
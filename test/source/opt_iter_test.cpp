@@ -1,13 +1,39 @@
+#include <opt_iter/adapt.hpp>
+#include <opt_iter/algorithm.hpp>
+#include <opt_iter/arena.hpp>
+#include <opt_iter/callbacks.hpp>
+#include <opt_iter/coro.hpp>
+#include <opt_iter/drive.hpp>
 #include <opt_iter/opt_iter.hpp>
+#include <opt_iter/pool.hpp>
+#include <opt_iter/segmented.hpp>
+#include <opt_iter/simd.hpp>
+#include <opt_iter/soa.hpp>
+#include <opt_iter/view.hpp>
 
 #include <boost/ut.hpp>
 #include <fmt/base.h>
 #include <fmt/ranges.h>
 #include <fmt/std.h>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <concepts>
+#include <expected>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <random>
 #include <optional>
 #include <ranges>
+#include <span>
+#include <stdexcept>
+#include <sstream>
+#include <string>
+#include <thread>
 #include <vector>
 
 namespace ut = boost::ut;
@@ -91,6 +117,447 @@ private:
     int m_limit = 0;
 };
 
+class IntSeqTry
+{
+public:
+    IntSeqTry(int limit, int fail_at)
+        : m_limit{ limit }
+        , m_fail_at{ fail_at }
+    {
+    }
+
+    std::expected<std::optional<int>, std::string> next()
+    {
+        if (m_value == m_fail_at) {
+            return std::unexpected{ "fail at " + std::to_string(m_value) };
+        }
+        if (m_value >= m_limit) {
+            return std::nullopt;
+        }
+        return m_value++;
+    }
+
+    void reset() { m_value = 0; }
+
+private:
+    int m_value   = 0;
+    int m_limit   = 0;
+    int m_fail_at = 0;
+};
+
+// an in-house compact optional that marks emptiness using a sentinel value
+struct CompactInt
+{
+    static constexpr int empty = std::numeric_limits<int>::min();
+
+    int value = empty;
+};
+
+template <>
+struct opt_iter::traits::OptTrait<CompactInt> : std::true_type
+{
+    using Type = int;
+
+    static bool has_value(const CompactInt& opt) { return opt.value != CompactInt::empty; }
+    static int& get(CompactInt& opt) { return opt.value; }
+    static void reset(CompactInt& opt) { opt.value = CompactInt::empty; }
+};
+
+class CompactSeq
+{
+public:
+    CompactSeq(int limit)
+        : m_limit{ limit }
+    {
+    }
+
+    CompactInt next()
+    {
+        if (m_value >= m_limit) {
+            return {};
+        }
+        return { m_value++ };
+    }
+
+    void reset() { m_value = 0; }
+
+private:
+    int m_value = 0;
+    int m_limit = 0;
+};
+
+// yields the sequence in blocks of at most 4 values, reusing the same buffer
+class IntSeqSpan
+{
+public:
+    IntSeqSpan(int limit)
+        : m_limit{ limit }
+    {
+    }
+
+    std::optional<std::span<const int>> next()
+    {
+        if (m_value >= m_limit) {
+            return std::nullopt;
+        }
+
+        auto count = 0uz;
+        while (count < m_buffer.size() and m_value < m_limit) {
+            m_buffer[count++] = m_value++;
+        }
+        return std::span{ m_buffer.data(), count };
+    }
+
+    void reset() { m_value = 0; }
+
+private:
+    std::array<int, 4> m_buffer = {};
+    int                m_value  = 0;
+    int                m_limit  = 0;
+};
+
+// refills the line in place, reusing the buffer of the string
+class LineReader
+{
+public:
+    LineReader(std::string str)
+        : m_stream{ std::move(str) }
+    {
+    }
+
+    bool next(std::string& line) { return static_cast<bool>(std::getline(m_stream, line)); }
+
+private:
+    std::istringstream m_stream;
+};
+
+class VecIter
+{
+public:
+    VecIter(std::vector<int> values)
+        : m_values{ std::move(values) }
+    {
+    }
+
+    std::optional<int> next()
+    {
+        if (m_index >= m_values.size()) {
+            return std::nullopt;
+        }
+        return m_values[m_index++];
+    }
+
+private:
+    std::vector<int> m_values;
+    std::size_t      m_index = 0;
+};
+
+// refills the same vector with batches of increasing size: {}, {0}, {0, 1}, ...
+class Batches
+{
+public:
+    Batches(int count)
+        : m_count{ count }
+    {
+    }
+
+    bool next(std::vector<int>& batch)
+    {
+        if (m_index >= m_count) {
+            return false;
+        }
+        batch.clear();
+        for (auto i = 0; i < m_index; ++i) {
+            batch.push_back(i);
+        }
+        ++m_index;
+        return true;
+    }
+
+private:
+    int m_index = 0;
+    int m_count = 0;
+};
+
+// sequence of [0, limit) that can skip values without generating them
+struct SkipSeq
+{
+    std::optional<int> next()
+    {
+        ++calls;
+        if (value >= limit) {
+            return std::nullopt;
+        }
+        return value++;
+    }
+
+    std::size_t skip(std::size_t n)
+    {
+        auto skipped  = std::min(n, static_cast<std::size_t>(limit - value));
+        value        += static_cast<int>(skipped);
+        return skipped;
+    }
+
+    int         limit = 0;
+    int         value = 0;
+    std::size_t calls = 0;
+};
+
+// yields vectors of [0, size) recycled through a pool
+class PooledBatches
+{
+public:
+    PooledBatches(int count)
+        : m_count{ count }
+    {
+    }
+
+    std::optional<opt_iter::Pooled<std::vector<int>>> next()
+    {
+        if (m_index >= m_count) {
+            return std::nullopt;
+        }
+
+        auto batch = m_pool.acquire();
+        batch->clear();
+        for (auto i = 0; i <= m_index % 4; ++i) {
+            batch->push_back(i);
+        }
+        ++m_index;
+        return batch;
+    }
+
+    opt_iter::Pool<std::vector<int>> m_pool;
+
+private:
+    int m_index = 0;
+    int m_count = 0;
+};
+
+// splits on ';' where "\\;" escapes the delimiter, unescaped fields are written into the arena
+class Unescaper
+{
+public:
+    Unescaper(std::string_view str, opt_iter::StringArena& arena)
+        : m_str{ str }
+        , m_arena{ &arena }
+    {
+    }
+
+    std::optional<std::string_view> next()
+    {
+        if (m_pos > m_str.size()) {
+            return std::nullopt;
+        }
+
+        auto end     = m_pos;
+        auto escaped = false;
+        while (end < m_str.size() and m_str[end] != ';') {
+            if (m_str[end] == '\\') {
+                escaped = true;
+                ++end;
+            }
+            ++end;
+        }
+        end = std::min(end, m_str.size());
+
+        auto field = m_str.substr(m_pos, end - m_pos);
+        m_pos      = end + 1;
+
+        // fields without escapes are yielded as they are
+        if (not escaped) {
+            return field;
+        }
+
+        auto builder = m_arena->builder();
+        for (auto i = 0uz; i < field.size(); ++i) {
+            if (field[i] == '\\' and i + 1 < field.size()) {
+                ++i;
+            }
+            builder.push_back(field[i]);
+        }
+        return builder.finish();
+    }
+
+private:
+    std::string_view       m_str;
+    std::size_t            m_pos = 0;
+    opt_iter::StringArena* m_arena;
+};
+
+// aggregate collected into struct-of-arrays layout
+struct Particle
+{
+    int         id;
+    float       mass;
+    std::string name;
+};
+
+// yields whether each value is even in blocks of 4 values, reusing the same buffer
+class ParitySpan
+{
+public:
+    ParitySpan(int limit)
+        : m_limit{ limit }
+    {
+    }
+
+    std::optional<std::span<const bool>> next()
+    {
+        if (m_value >= m_limit) {
+            return std::nullopt;
+        }
+
+        auto count = 0uz;
+        while (count < m_buffer.size() and m_value < m_limit) {
+            m_buffer[count++] = m_value++ % 2 == 0;
+        }
+        return std::span{ m_buffer.data(), count };
+    }
+
+private:
+    std::array<bool, 4> m_buffer = {};
+    int                 m_value  = 0;
+    int                 m_limit  = 0;
+};
+
+// counts the number of next() calls, infinite
+struct CountingSeq
+{
+    std::optional<int> next()
+    {
+        ++calls;
+        return value++;
+    }
+
+    int value = 0;
+    int calls = 0;
+};
+
+// counts the number of constructions through the given counter
+class ConstructCounted
+{
+public:
+    ConstructCounted(int& count, int limit)
+        : m_limit{ limit }
+    {
+        ++count;
+    }
+
+    std::optional<int> next()
+    {
+        if (m_value >= m_limit) {
+            return std::nullopt;
+        }
+        return m_value++;
+    }
+
+private:
+    int m_value = 0;
+    int m_limit = 0;
+};
+
+// neither copyable nor movable because of the mutex
+class LockedSeq
+{
+public:
+    LockedSeq(int limit)
+        : m_limit{ limit }
+    {
+    }
+
+    std::optional<int> next()
+    {
+        auto lock = std::scoped_lock{ m_mutex };
+        if (m_value >= m_limit) {
+            return std::nullopt;
+        }
+        return m_value++;
+    }
+
+private:
+    std::mutex m_mutex;
+    int        m_value = 0;
+    int        m_limit = 0;
+};
+
+// 3x3 stencil offsets, the number of values is known at compile time
+class Stencil
+{
+public:
+    using static_size = std::integral_constant<std::size_t, 9>;
+
+    std::optional<std::pair<int, int>> next()
+    {
+        if (m_index >= static_size::value) {
+            return std::nullopt;
+        }
+        auto index = static_cast<int>(m_index++);
+        return std::pair{ index % 3 - 1, index / 3 - 1 };
+    }
+
+private:
+    std::size_t m_index = 0;
+};
+
+// double-ended sequence of [first, last)
+class IntRange
+{
+public:
+    IntRange(int first, int last)
+        : m_first{ first }
+        , m_last{ last }
+    {
+    }
+
+    std::optional<int> next()
+    {
+        if (m_first >= m_last) {
+            return std::nullopt;
+        }
+        return m_first++;
+    }
+
+    std::optional<int> next_back()
+    {
+        if (m_first >= m_last) {
+            return std::nullopt;
+        }
+        return --m_last;
+    }
+
+private:
+    int m_first = 0;
+    int m_last  = 0;
+};
+
+opt_iter::Coro<int> coro_iota(int limit)
+{
+    for (auto i = 0; i < limit; ++i) {
+        co_yield i;
+    }
+}
+
+opt_iter::Coro<std::string> coro_words(std::string_view text)
+{
+    auto word = std::string{};
+    for (auto c : text) {
+        if (c == ' ') {
+            co_yield std::move(word);
+            word.clear();
+        } else {
+            word.push_back(c);
+        }
+    }
+    co_yield std::move(word);
+}
+
+opt_iter::Coro<int> coro_throwing()
+{
+    co_yield 1;
+    throw std::runtime_error{ "coro" };
+}
+
 // I need to use this since the paramterized tests for type provided by ut by default require the type to be
 // default-initializable and copyable
 template <typename Tuple, typename Fn>
@@ -285,6 +752,1037 @@ int main()
         static_assert(std::same_as<decltype(range), opt_iter::OwnedRangeFn<decltype(lambda), int>>);
     };
 
+    "IntSeqTry should be considered as satisfying OptIter concept through HasTryNext"_test = [] {
+        static_assert(opt_iter::OptIter<IntSeqTry>);
+        static_assert(opt_iter::traits::HasTryNext<IntSeqTry>);
+        static_assert(not opt_iter::traits::HasNext<IntSeqTry>);
+        static_assert(not opt_iter::traits::HasCallOp<IntSeqTry>);
+        static_assert(std::same_as<opt_iter::traits::OptIterTrait<IntSeqTry>::Error, std::string>);
+    };
+
+    "RangeTry and OwnedRangeTry should satisfy input range and viewable range concept"_test = [] {
+        using RangeTry = opt_iter::RangeTry<IntSeqTry, int, std::string, false>;
+        static_assert(std::ranges::input_range<RangeTry>);
+        static_assert(std::ranges::viewable_range<RangeTry>);
+
+        using OwnedRangeTry = opt_iter::OwnedRangeTry<IntSeqTry, int, std::string>;
+        static_assert(std::ranges::input_range<OwnedRangeTry>);
+        static_assert(std::ranges::viewable_range<OwnedRangeTry>);
+    };
+
+    "make, make_with, and make_owned should construct RangeTry/OwnedRangeTry for HasTryNext"_test = [] {
+        auto int_seq = IntSeqTry{ 5, -1 };
+        auto range   = opt_iter::make(int_seq);
+        static_assert(std::same_as<decltype(range), opt_iter::RangeTry<IntSeqTry, int, std::string, true>>);
+
+        auto storage = std::optional<int>{};
+        auto range2  = opt_iter::make_with(storage, int_seq);
+        static_assert(std::same_as<decltype(range2), opt_iter::RangeTry<IntSeqTry, int, std::string, false>>);
+
+        auto range3 = opt_iter::make_owned<IntSeqTry>(5, -1);
+        static_assert(std::same_as<decltype(range3), opt_iter::OwnedRangeTry<IntSeqTry, int, std::string>>);
+    };
+
+    "*RangeTry should stop at the first error and expose it"_test = [] {
+        auto range = opt_iter::make_owned<IntSeqTry>(100, 10);
+
+        const auto actual = range | sr::to<std::vector>();
+        expect(that % actual == (sv::iota(0, 10) | sr::to<std::vector>()));
+        expect(range.error() == std::optional<std::string>{ "fail at 10" });
+
+        // the error is sticky until cleared
+        expect(sr::distance(range) == 0);
+
+        range.underlying().reset();
+        range.clear();
+        expect(range.error() == std::nullopt);
+        expect(that % (range | sv::take(5) | sr::to<std::vector>()) == std::vector{ 0, 1, 2, 3, 4 });
+    };
+
+    "try_collect should return the container or the error"_test = [] {
+        auto ok = opt_iter::try_collect<std::vector>(opt_iter::make_owned<IntSeqTry>(10, -1));
+        expect(ok.has_value());
+        expect(that % ok.value() == (sv::iota(0, 10) | sr::to<std::vector>()));
+
+        auto int_seq = IntSeqTry{ 10, 3 };
+        auto range   = opt_iter::make(int_seq);
+        auto err     = opt_iter::try_collect<std::vector<int>>(range);
+        expect(not err.has_value());
+        expect(err.error() == "fail at 3");
+    };
+
+    "Optional-like type with OptTrait specialization should be stored directly"_test = [] {
+        static_assert(opt_iter::traits::OptLike<CompactInt>);
+        static_assert(opt_iter::OptIter<CompactSeq>);
+        static_assert(std::same_as<opt_iter::traits::OptIterTrait<CompactSeq>::Ret, int>);
+        static_assert(std::same_as<opt_iter::traits::OptIterTrait<CompactSeq>::Opt, CompactInt>);
+        static_assert(std::input_iterator<opt_iter::Iterator<CompactSeq, int>>);
+
+        auto owned = opt_iter::make_owned<CompactSeq>(10);
+        static_assert(std::same_as<decltype(owned)::Opt, CompactInt>);
+        expect(that % (owned | sr::to<std::vector>()) == (sv::iota(0, 10) | sr::to<std::vector>()));
+
+        auto compact_seq = CompactSeq{ 10 };
+        auto storage     = CompactInt{};
+        auto range       = opt_iter::make_with(storage, compact_seq);
+        expect(that % (range | sv::take(3) | sr::to<std::vector>()) == std::vector{ 0, 1, 2 });
+        expect(storage.value == 3);
+    };
+
+    "SpanWrapper should iterate the values of the spans one by one"_test = [] {
+        static_assert(opt_iter::traits::HasSpanNext<IntSeqSpan>);
+        static_assert(not opt_iter::traits::HasSpanNext<IntSeq>);
+
+        auto owned = opt_iter::make_span_owned<IntSeqSpan>(10);
+        static_assert(std::same_as<decltype(owned)::Ret, int>);
+        static_assert(std::ranges::input_range<decltype(owned)>);
+        expect(that % (owned | sr::to<std::vector>()) == (sv::iota(0, 10) | sr::to<std::vector>()));
+
+        auto int_seq = IntSeqSpan{ 10 };
+        auto range   = opt_iter::make_span(int_seq);
+        expect(that % (range | sv::take(5) | sr::to<std::vector>()) == std::vector{ 0, 1, 2, 3, 4 });
+        expect(that % (range | sr::to<std::vector>()) == std::vector{ 5, 6, 7, 8, 9 });
+    };
+
+    "Iterable with bool next(R&) should refill the storage in place"_test = [] {
+        static_assert(opt_iter::OptIter<LineReader>);
+        static_assert(opt_iter::traits::HasNextInto<LineReader>);
+        static_assert(not opt_iter::traits::HasNext<LineReader>);
+        static_assert(std::same_as<opt_iter::traits::OptIterTrait<LineReader>::Ret, std::string>);
+
+        using Iterator = opt_iter::Iterator<LineReader, std::string>;
+        static_assert(std::input_iterator<Iterator>);
+        static_assert(std::same_as<std::iter_reference_t<Iterator>, std::string&>);
+
+        auto reader = opt_iter::make_owned<LineReader>("a line that is long enough\nsecond\nthird");
+        static_assert(std::same_as<decltype(reader), opt_iter::OwnedRange<LineReader, std::string>>);
+
+        auto it     = reader.begin();
+        auto buffer = (*it).data();
+        expect(*it == "a line that is long enough");
+
+        ++it;
+        expect(*it == "second");
+        expect((*it).data() == buffer);    // same buffer, no reallocation
+
+        ++it;
+        expect(*it == "third");
+        ++it;
+        expect(it == reader.end());
+
+        auto storage = opt_iter::traits::RefillOpt<std::string>{};
+        auto reader2 = LineReader{ "1\n2\n3" };
+        auto range   = opt_iter::make_with(storage, reader2);
+        expect(that % (range | sr::to<std::vector>()) == std::vector<std::string>{ "1", "2", "3" });
+    };
+
+    "Lazy iterator should satisfy input iterator concept"_test = [] {
+        using Iterator = opt_iter::Iterator<IntSeq, int, opt_iter::Advance::Lazy>;
+        static_assert(std::input_iterator<Iterator>);
+        static_assert(std::sentinel_for<opt_iter::Sentinel, Iterator>);
+
+        using Range = opt_iter::OwnedRange<IntSeq, int, opt_iter::Advance::Lazy>;
+        static_assert(std::ranges::input_range<Range>);
+        static_assert(std::ranges::viewable_range<Range>);
+    };
+
+    "Lazy range should not generate past the point where the consumer stops"_test = [] {
+        auto eager = opt_iter::make_owned<CountingSeq>();
+        auto lazy  = opt_iter::make_owned<CountingSeq, opt_iter::Advance::Lazy>();
+        static_assert(std::same_as<decltype(lazy), opt_iter::OwnedRange<CountingSeq, int, opt_iter::Advance::Lazy>>);
+
+        const auto expected_1 = sv::iota(0, 10) | sr::to<std::vector>();
+        const auto expected_2 = sv::iota(10, 20) | sr::to<std::vector>();
+
+        expect(that % (eager | sv::take(10) | sr::to<std::vector>()) == expected_1);
+        expect(that % (lazy | sv::take(10) | sr::to<std::vector>()) == expected_1);
+        expect(eager.underlying().calls == 11);
+        expect(lazy.underlying().calls == 10);
+
+        // iteration resumes from where it stopped
+        expect(that % (eager | sv::take(10) | sr::to<std::vector>()) == expected_2);
+        expect(that % (lazy | sv::take(10) | sr::to<std::vector>()) == expected_2);
+        expect(eager.underlying().calls == 21);
+        expect(lazy.underlying().calls == 20);
+
+        // begin() alone doesn't call next()
+        auto counting = CountingSeq{};
+        auto range    = opt_iter::make<opt_iter::Advance::Lazy>(counting);
+        auto it       = range.begin();
+        expect(counting.calls == 0);
+        expect(*it == 0);
+        expect(counting.calls == 1);
+
+        // consecutive increments consume the values they skip
+        auto skipped    = CountingSeq{};
+        auto lazy_range = opt_iter::make<opt_iter::Advance::Lazy>(skipped);
+        auto lazy_it    = lazy_range.begin();
+        ++lazy_it;
+        ++lazy_it;
+        expect(*lazy_it == 2);
+        expect(*std::ranges::next(lazy_it, 3) == 5);
+        expect(that % (lazy_range | sv::take(2) | sr::to<std::vector>()) == std::vector{ 5, 6 });
+    };
+
+    "DeferredRange should only construct the iterable on the first begin()"_test = [] {
+        auto count = 0;
+        {
+            auto unused = opt_iter::make_deferred<ConstructCounted>(std::ref(count), 10);
+            static_assert(std::ranges::input_range<decltype(unused)>);
+            static_assert(std::ranges::viewable_range<decltype(unused)>);
+            expect(not unused.constructed());
+        }
+        expect(count == 0);
+
+        auto range = opt_iter::make_deferred<ConstructCounted>(std::ref(count), 10);
+        expect(that % (range | sv::take(5) | sr::to<std::vector>()) == std::vector{ 0, 1, 2, 3, 4 });
+        expect(that % (range | sr::to<std::vector>()) == std::vector{ 5, 6, 7, 8, 9 });
+        expect(range.constructed());
+        expect(count == 1);
+
+        auto lambda = opt_iter::make_deferred<IntSeq2, opt_iter::Advance::Lazy>(3);
+        expect(that % (lambda | sr::to<std::vector>()) == std::vector{ 0, 1, 2 });
+    };
+
+    "OwnedRange should construct the iterable in place so it doesn't need to be movable"_test = [] {
+        static_assert(not std::movable<LockedSeq>);
+        static_assert(std::constructible_from<opt_iter::OwnedRange<LockedSeq, int>, int>);
+
+        auto range = opt_iter::make_owned<LockedSeq>(5);
+        static_assert(std::ranges::viewable_range<decltype(range)>);
+        expect(that % (range | sr::to<std::vector>()) == std::vector{ 0, 1, 2, 3, 4 });
+    };
+
+    "reset() should reset both the iterable and the storage"_test = [] {
+        static_assert(opt_iter::traits::HasReset<IntSeq>);
+        static_assert(not opt_iter::traits::HasReset<LineReader>);
+
+        const auto expected = std::vector{ 0, 1, 2, 3, 4 };
+
+        auto owned = opt_iter::make_owned<IntSeq>(100);
+        auto fn    = opt_iter::make_owned<IntSeq2>(100);
+        auto tried = opt_iter::make_owned<IntSeqTry>(100, 3);
+        auto span  = opt_iter::make_span_owned<IntSeqSpan>(100);
+
+        for (auto i = 0; i < 3; ++i) {
+            expect(that % (owned | sv::take(5) | sr::to<std::vector>()) == expected);
+            expect(that % (fn | sv::take(5) | sr::to<std::vector>()) == expected);
+            expect(that % (span | sv::take(5) | sr::to<std::vector>()) == expected);
+            expect(that % (tried | sr::to<std::vector>()) == std::vector{ 0, 1, 2 });
+            expect(tried.error().has_value());
+
+            owned.reset();
+            fn.reset();
+            span.reset();
+            tried.reset();
+            expect(not tried.error().has_value());
+        }
+
+        auto int_seq = IntSeq{ 100 };
+        auto storage = std::optional<int>{};
+        auto range   = opt_iter::make_with(storage, int_seq);
+        expect(that % (range | sv::take(5) | sr::to<std::vector>()) == expected);
+        range.reset();
+        expect(storage == std::nullopt);
+        expect(that % (range | sv::take(5) | sr::to<std::vector>()) == expected);
+    };
+
+    "checkpoint(), restore(), and fork() should capture and continue from the current state"_test = [] {
+        const auto take_3 = [](auto& range) { return range | sv::take(3) | sr::to<std::vector>(); };
+
+        auto owned = opt_iter::make_owned<IntSeq>(100);
+        expect(that % take_3(owned) == std::vector{ 0, 1, 2 });
+
+        auto checkpoint = owned.checkpoint();
+        expect(that % take_3(owned) == std::vector{ 3, 4, 5 });
+
+        owned.restore(checkpoint);
+        expect(that % take_3(owned) == std::vector{ 3, 4, 5 });
+
+        auto forked = owned.fork();
+        static_assert(std::same_as<decltype(forked), opt_iter::OwnedRange<IntSeq, int>>);
+        expect(that % take_3(forked) == std::vector{ 6, 7, 8 });
+        expect(that % take_3(forked) == std::vector{ 9, 10, 11 });
+        expect(that % take_3(owned) == std::vector{ 6, 7, 8 });
+
+        auto int_seq2 = IntSeq2{ 100 };
+        auto range    = opt_iter::make(int_seq2);
+        expect(that % take_3(range) == std::vector{ 0, 1, 2 });
+
+        auto forked2 = range.fork();
+        static_assert(std::same_as<decltype(forked2), opt_iter::OwnedRangeFn<IntSeq2, int>>);
+        expect(that % take_3(forked2) == std::vector{ 3, 4, 5 });
+        expect(that % take_3(range) == std::vector{ 3, 4, 5 });
+
+        // the fork of a span-backed range doesn't refer to the span of the original
+        auto forked_span = std::optional<opt_iter::OwnedRange<opt_iter::SpanWrapper<IntSeqSpan>, int>>{};
+        {
+            auto span = opt_iter::make_span_owned<IntSeqSpan>(10);
+            static_cast<void>(span.begin());
+            forked_span.emplace(span.fork());
+            expect(that % (span | sr::to<std::vector>()) == (sv::iota(0, 10) | sr::to<std::vector>()));
+        }
+        expect(that % (*forked_span | sr::to<std::vector>()) == (sv::iota(0, 10) | sr::to<std::vector>()));
+
+        auto span = opt_iter::make_span_owned<IntSeqSpan>(10);
+        static_cast<void>(span.begin());
+        auto span_checkpoint = span.checkpoint();
+        expect(that % take_3(span) == std::vector{ 0, 1, 2 });
+        expect(that % take_3(span) == std::vector{ 3, 4, 5 });
+        span.restore(span_checkpoint);
+        expect(that % (span | sr::to<std::vector>()) == (sv::iota(0, 10) | sr::to<std::vector>()));
+
+        // the values left in a span of bool are copied one by one
+        auto parity = opt_iter::make_span_owned<ParitySpan>(6);
+        static_cast<void>(parity.begin());
+        auto parity_fork = parity.fork();
+        expect(that % (parity | sr::to<std::vector>()) == std::vector{ true, false, true, false, true, false });
+        expect(that % (parity_fork | sr::to<std::vector>()) == std::vector{ true, false, true, false, true, false });
+    };
+
+    "range of iterable with static_size should have its terminal operations unrolled"_test = [] {
+        static_assert(opt_iter::traits::HasStaticSize<Stencil>);
+        static_assert(not opt_iter::traits::HasStaticSize<IntSeq>);
+
+        // only a freshly made owned range is known to yield exactly static_size values
+        using Owned = decltype(opt_iter::make_owned<Stencil>());
+        static_assert(not std::ranges::sized_range<Owned>);
+        static_assert(opt_iter::StaticSizedRange<Owned>);
+        static_assert(not opt_iter::StaticSizedRange<Owned&>);
+
+        auto stencil = Stencil{};
+        auto range   = opt_iter::make(stencil);
+        static_assert(not std::ranges::sized_range<decltype(range)>);
+        static_assert(not opt_iter::StaticSizedRange<decltype(range)>);
+
+        auto offsets  = opt_iter::collect_array(opt_iter::make_owned<Stencil>());
+        auto expected = std::array<std::pair<int, int>, 9>{ {
+            { -1, -1 }, { 0, -1 }, { 1, -1 },
+            { -1, 0 },  { 0, 0 },  { 1, 0 },
+            { -1, 1 },  { 0, 1 },  { 1, 1 },
+        } };
+        expect(offsets == expected);
+
+        auto sum = opt_iter::fold(opt_iter::make_owned<Stencil>(), 0, [](int acc, auto offset) {
+            return acc + offset.first + 10 * offset.second;
+        });
+        expect(that % sum == 0);
+
+        auto count = 0;
+        opt_iter::for_each(opt_iter::make_owned<Stencil>(), [&](auto) { ++count; });
+        expect(that % count == 9);
+
+        // a partially iterated range still stops at its end
+        auto skip_stencil = [](int n) {
+            auto partial = Stencil{};
+            for (auto i = 0; i < n; ++i) {
+                static_cast<void>(partial.next());
+            }
+            return partial;
+        };
+
+        auto partial = skip_stencil(4);
+        expect(that % std::ranges::distance(opt_iter::make(partial) | std::views::take(9)) == 5);
+
+        auto partial_owned = opt_iter::make_owned<Stencil>();
+        static_cast<void>(partial_owned.underlying().next());
+        auto remaining = 0;
+        opt_iter::for_each(partial_owned, [&](auto) { ++remaining; });
+        expect(that % remaining == 8);
+
+        auto last_row = skip_stencil(6);
+        auto row_sum  = opt_iter::fold(opt_iter::make(last_row), 0, [](int acc, auto offset) {
+            return acc + offset.second;
+        });
+        expect(that % row_sum == 3);
+
+        // ranges without static size are iterated until the end
+        auto int_seq = IntSeq{ 10 };
+        expect(that % opt_iter::fold(opt_iter::make(int_seq), 0, std::plus{}) == 45);
+    };
+
+    "adapt should compose OptIter pipelines that are OptIter themselves"_test = [] {
+        namespace adapt = opt_iter::adapt;
+
+        auto is_even  = [](int v) { return v % 2 == 0; };
+        auto square   = [](int v) { return v * v; };
+        auto pipeline = IntSeq{ 100 } | adapt::filter(is_even) | adapt::map(square) | adapt::take(4);
+        static_assert(opt_iter::OptIter<decltype(pipeline)>);
+
+        expect(that % (opt_iter::make(pipeline) | sr::to<std::vector>()) == std::vector{ 0, 4, 16, 36 });
+
+        // the parent is referenced if it's an lvalue, take stops calling it once the count is reached
+        auto int_seq = IntSeq{ 10 };
+        auto taken   = adapt::take(int_seq, 3);
+        expect(that % (opt_iter::make(taken) | sr::to<std::vector>()) == std::vector{ 0, 1, 2 });
+        expect(that % int_seq.next().value() == 3);
+
+        auto half = [](int v) { return v % 2 == 0 ? std::optional{ v / 2 } : std::nullopt; };
+        auto less = [](int limit) { return [=](int v) { return v < limit; }; };
+
+        auto filter_mapped = IntSeq{ 10 } | adapt::filter_map(half);
+        expect(that % (opt_iter::make(filter_mapped) | sr::to<std::vector>()) == std::vector{ 0, 1, 2, 3, 4 });
+
+        auto taken_while = IntSeq{ 10 } | adapt::take_while(less(4));
+        expect(that % (opt_iter::make(taken_while) | sr::to<std::vector>()) == std::vector{ 0, 1, 2, 3 });
+
+        auto skipped = IntSeq{ 10 } | adapt::skip_while(less(7));
+        expect(that % (opt_iter::make(skipped) | sr::to<std::vector>()) == std::vector{ 7, 8, 9 });
+
+        using Pair      = std::pair<std::size_t, int>;
+        auto enumerated = IntSeq{ 3 } | adapt::map([](int v) { return v * 10; }) | adapt::enumerate();
+        expect(
+            that % (opt_iter::make(enumerated) | sr::to<std::vector>())
+            == std::vector<Pair>{ { 0, 0 }, { 1, 10 }, { 2, 20 } }
+        );
+
+        // running sum that stops once it exceeds 10
+        auto running = IntSeq{ 10 } | adapt::scan(0, [](int& sum, int v) {
+                           sum += v;
+                           return sum > 10 ? std::nullopt : std::optional{ sum };
+                       });
+        expect(that % (opt_iter::make(running) | sr::to<std::vector>()) == std::vector{ 0, 1, 3, 6, 10 });
+
+        // move-only state
+        auto boxed = IntSeq{ 4 } | adapt::scan(std::make_unique<int>(0), [](std::unique_ptr<int>& sum, int v) {
+                         *sum += v;
+                         return std::optional{ *sum };
+                     });
+        expect(that % (opt_iter::make(boxed) | sr::to<std::vector>()) == std::vector{ 0, 1, 3, 6 });
+
+        auto seen      = std::vector<int>{};
+        auto inspected = IntSeq{ 3 } | adapt::inspect([&](int v) { seen.push_back(v); });
+        expect(that % (opt_iter::make(inspected) | sr::to<std::vector>()) == std::vector{ 0, 1, 2 });
+        expect(that % seen == std::vector{ 0, 1, 2 });
+
+        // reset is forwarded to the parent
+        auto resettable = IntSeq{ 10 } | adapt::enumerate() | adapt::take(2);
+        auto range      = opt_iter::make_owned<decltype(resettable)>(std::move(resettable));
+        expect(that % (range | sr::to<std::vector>()) == std::vector<Pair>{ { 0, 0 }, { 1, 1 } });
+        range.reset();
+        expect(that % (range | sr::to<std::vector>()) == std::vector<Pair>{ { 0, 0 }, { 1, 1 } });
+    };
+
+    "group_by should group consecutive values lazily and skip the unconsumed remainder"_test = [] {
+        auto request_id = [](int v) { return v / 10; };
+        auto values     = std::vector{ 1, 2, 3, 11, 12, 21, 31, 32, 33, 34, 5 };
+
+        auto vec_iter = VecIter{ values };
+        auto groups   = std::vector<std::pair<int, std::vector<int>>>{};
+        for (auto group : opt_iter::group_by(opt_iter::make(vec_iter), request_id)) {
+            groups.emplace_back(group.key(), group | sr::to<std::vector>());
+        }
+        expect(
+            that % groups
+            == std::vector<std::pair<int, std::vector<int>>>{
+                { 0, { 1, 2, 3 } }, { 1, { 11, 12 } }, { 2, { 21 } }, { 3, { 31, 32, 33, 34 } }, { 0, { 5 } },
+            }
+        );
+
+        // only take the first value of each group, the rest are skipped
+        auto firsts = std::vector<int>{};
+        for (auto group : opt_iter::group_by(opt_iter::make_owned<VecIter>(values), request_id)) {
+            firsts.push_back(*group.begin());
+        }
+        expect(that % firsts == std::vector{ 1, 11, 21, 31, 5 });
+
+        // groups of lines refilled in place share the storage of the parent
+        auto lines = LineReader{ "a:1\na:2\nb:1\nc:1\nc:2\nc:3" };
+        auto sizes = std::vector<std::size_t>{};
+        for (auto group : opt_iter::group_by(opt_iter::make(lines), [](const std::string& l) { return l[0]; })) {
+            sizes.push_back(static_cast<std::size_t>(std::ranges::distance(group)));
+        }
+        expect(that % sizes == std::vector<std::size_t>{ 2, 1, 3 });
+
+        auto empty_seq = IntSeq{ 0 };
+        expect(that % std::ranges::distance(opt_iter::group_by(opt_iter::make(empty_seq), request_id)) == 0);
+
+        // a const range is iterated through its const iterator, the values are referenced as const
+        const auto& const_values = values;
+        auto        const_groups = opt_iter::group_by(const_values, request_id);
+        auto        group_sizes  = std::vector<std::size_t>{};
+        for (auto group : const_groups) {
+            static_assert(std::same_as<decltype(*group.begin()), const int&>);
+            expect(&*group.begin() >= values.data() and &*group.begin() < values.data() + values.size());
+            group_sizes.push_back(static_cast<std::size_t>(std::ranges::distance(group)));
+        }
+        expect(that % group_sizes == std::vector<std::size_t>{ 3, 2, 1, 4, 1 });
+    };
+
+    "windows should yield overlapping windows as contiguous spans"_test = [] {
+        auto to_vectors = [](auto&& windows) {
+            auto result = std::vector<std::vector<int>>{};
+            for (auto window : windows) {
+                result.emplace_back(window.begin(), window.end());
+            }
+            return result;
+        };
+
+        auto int_seq = IntSeq{ 5 };
+        auto pairs   = opt_iter::windows<2>(opt_iter::make(int_seq));
+        static_assert(std::same_as<std::ranges::range_value_t<decltype(pairs)>, std::span<const int, 2>>);
+        expect(that % to_vectors(pairs) == std::vector<std::vector<int>>{ { 0, 1 }, { 1, 2 }, { 2, 3 }, { 3, 4 } });
+
+        auto triples = opt_iter::windows(opt_iter::make_owned<IntSeq>(6), 3);
+        expect(
+            that % to_vectors(triples)
+            == std::vector<std::vector<int>>{ { 0, 1, 2 }, { 1, 2, 3 }, { 2, 3, 4 }, { 3, 4, 5 } }
+        );
+
+        // the parent is only advanced when the next window is needed
+        auto counting = CountingSeq{};
+        for (auto window : opt_iter::windows<4>(opt_iter::make<opt_iter::Advance::Lazy>(counting))) {
+            if (window[0] == 2) {
+                break;
+            }
+        }
+        expect(that % counting.calls == 6);
+
+        auto short_seq = IntSeq{ 2 };
+        expect(that % std::ranges::distance(opt_iter::windows<3>(opt_iter::make(short_seq))) == 0);
+
+        // a const container is iterated through its const iterator
+        const auto values = std::vector{ 1, 2, 3, 4 };
+        expect(
+            that % to_vectors(opt_iter::windows<2>(values))
+            == std::vector<std::vector<int>>{ { 1, 2 }, { 2, 3 }, { 3, 4 } }
+        );
+        expect(
+            that % to_vectors(opt_iter::windows(values, 3)) == std::vector<std::vector<int>>{ { 1, 2, 3 }, { 2, 3, 4 } }
+        );
+    };
+
+    "flatten and flat_map should iterate the inner ranges and OptIters in place"_test = [] {
+        auto batches   = Batches{ 4 };
+        auto flattened = opt_iter::flatten(opt_iter::make(batches));
+        static_assert(std::same_as<std::ranges::range_reference_t<decltype(flattened)>, int&>);
+        expect(that % (flattened | sr::to<std::vector>()) == std::vector{ 0, 0, 1, 0, 1, 2 });
+
+        // inner OptIter is iterated through a single storage
+        auto int_seq  = IntSeq{ 4 };
+        auto seqs     = opt_iter::flat_map(opt_iter::make(int_seq), [](int v) { return IntSeq{ v }; });
+        auto expected = std::vector{ 0, 0, 1, 0, 1, 2 };
+        expect(that % (seqs | sr::to<std::vector>()) == expected);
+
+        // inner values yielded by value are moved into the slot of the view
+        auto vecs = opt_iter::flat_map(opt_iter::make_owned<IntSeq>(3), [](int v) {
+            return std::vector<std::string>(static_cast<std::size_t>(v), std::to_string(v));
+        });
+        expect(that % (vecs | sr::to<std::vector>()) == std::vector<std::string>{ "1", "2", "2" });
+
+        auto empty_seq = IntSeq{ 0 };
+        auto empty     = opt_iter::flat_map(opt_iter::make(empty_seq), [](int v) { return IntSeq{ v }; });
+        expect(that % std::ranges::distance(empty) == 0);
+
+        // a const outer range is iterated through its const iterator, the inner ranges are referenced as const
+        const auto nested = std::vector<std::vector<int>>{ { 1, 2 }, {}, { 3 } };
+        auto       flat   = opt_iter::flatten(nested);
+        static_assert(std::same_as<std::ranges::range_reference_t<decltype(flat)>, const int&>);
+        expect(that % (flat | sr::to<std::vector>()) == std::vector{ 1, 2, 3 });
+
+        auto sizes = opt_iter::flat_map(nested, [](const std::vector<int>& v) {
+            return IntSeq{ static_cast<int>(v.size()) };
+        });
+        expect(that % (sizes | sr::to<std::vector>()) == std::vector{ 0, 1, 0 });
+    };
+
+    "chunks should yield spans over a reused buffer with a shorter last chunk"_test = [] {
+        auto int_seq = IntSeq{ 7 };
+        auto chunks  = opt_iter::chunks(opt_iter::make(int_seq), 3);
+        static_assert(std::same_as<std::ranges::range_value_t<decltype(chunks)>, std::span<int>>);
+
+        auto result = std::vector<std::vector<int>>{};
+        auto data   = std::vector<const int*>{};
+        for (auto chunk : chunks) {
+            result.emplace_back(chunk.begin(), chunk.end());
+            data.push_back(chunk.data());
+        }
+        expect(that % result == std::vector<std::vector<int>>{ { 0, 1, 2 }, { 3, 4, 5 }, { 6 } });
+        expect(data[0] == data[1] and data[1] == data[2]);
+
+        auto exact = opt_iter::chunks(opt_iter::make_owned<IntSeq>(4), 2);
+        expect(that % std::ranges::distance(exact) == 2);
+
+        auto empty_seq = IntSeq{ 0 };
+        expect(that % std::ranges::distance(opt_iter::chunks(opt_iter::make(empty_seq), 3)) == 0);
+
+        // the parent is not advanced past its end after a shorter last chunk
+        auto values = std::vector{ 1, 2, 3, 4, 5 };
+        auto sizes  = std::vector<std::size_t>{};
+        for (auto chunk : opt_iter::chunks(values, 2)) {
+            sizes.push_back(chunk.size());
+        }
+        expect(that % sizes == std::vector<std::size_t>{ 2, 2, 1 });
+
+        auto calls = 0;
+        auto gen   = [&, value = 0]() mutable -> std::optional<int> {
+            ++calls;
+            return value < 5 ? std::optional{ value++ } : std::nullopt;
+        };
+        expect(that % std::ranges::distance(opt_iter::chunks(opt_iter::make(gen), 2)) == 3);
+        expect(that % calls == 6);
+
+        // the values of a const range are copied and the chunks are read-only
+        const auto& const_values = values;
+        auto        const_chunks = opt_iter::chunks(const_values, 2);
+        static_assert(std::same_as<std::ranges::range_value_t<decltype(const_chunks)>, std::span<const int>>);
+
+        auto copied = std::vector<std::vector<int>>{};
+        for (auto chunk : const_chunks) {
+            copied.emplace_back(chunk.begin(), chunk.end());
+        }
+        expect(that % copied == std::vector<std::vector<int>>{ { 1, 2 }, { 3, 4 }, { 5 } });
+    };
+
+    "sample should pick k distinct values and skip the gaps using skip()"_test = [] {
+        static_assert(opt_iter::traits::HasSkip<SkipSeq>);
+
+        auto rng  = std::mt19937{ 42 };
+        auto seq  = SkipSeq{ .limit = 1'000'000 };
+        auto pick = opt_iter::sample(seq, 10, rng);
+        expect(that % pick.size() == 10uz);
+        expect(that % seq.value == 1'000'000);
+        expect(seq.calls < 10'000);    // the gaps are skipped, not generated
+
+        std::ranges::sort(pick);
+        expect(std::ranges::adjacent_find(pick) == pick.end());
+        expect(pick.front() >= 0 and pick.back() < 1'000'000);
+
+        // without skip(), every value is generated
+        auto int_seq = IntSeq{ 1000 };
+        expect(that % opt_iter::sample(int_seq, 10, rng).size() == 10uz);
+        expect(not int_seq.next().has_value());
+
+        // works on any input range, a shorter range is returned whole
+        auto small = opt_iter::sample(opt_iter::make_owned<IntSeq>(3), 10, rng);
+        std::ranges::sort(small);
+        expect(that % small == std::vector{ 0, 1, 2 });
+
+        // each value is roughly equally likely to be picked
+        auto counts = std::array<int, 10>{};
+        for (auto i = 0; i < 2000; ++i) {
+            auto ten = IntSeq{ 10 };
+            for (auto v : opt_iter::sample(ten, 2, rng)) {
+                ++counts[static_cast<std::size_t>(v)];
+            }
+        }
+        expect(std::ranges::all_of(counts, [](int c) { return c > 300 and c < 500; }));
+    };
+
+    "adapt::bernoulli should keep each value with probability p"_test = [] {
+        namespace adapt = opt_iter::adapt;
+
+        auto rng = std::mt19937{ 42 };
+
+        auto all = SkipSeq{ .limit = 100 } | adapt::bernoulli(1.0, rng);
+        expect(that % (opt_iter::make(all) | sr::to<std::vector>()) == (sv::iota(0, 100) | sr::to<std::vector>()));
+
+        auto none = SkipSeq{ .limit = 100 } | adapt::bernoulli(0.0, rng);
+        expect(that % std::ranges::distance(opt_iter::make(none)) == 0);
+
+        auto seq  = SkipSeq{ .limit = 1'000'000 };
+        auto some = adapt::bernoulli(seq, 0.001, rng);
+        auto kept = opt_iter::make(some) | sr::to<std::vector>();
+        expect(kept.size() > 800uz and kept.size() < 1200uz);
+        expect(std::ranges::is_sorted(kept));
+        expect(seq.calls < 2000uz);    // the gaps are skipped, not generated
+    };
+
+    "Coro should be an OptIter that yields directly into the storage of the range"_test = [] {
+        static_assert(opt_iter::traits::HasNextInto<opt_iter::Coro<int>>);
+
+        auto iota = opt_iter::make_owned<opt_iter::Coro<int>>(coro_iota(5));
+        static_assert(std::same_as<std::ranges::range_reference_t<decltype(iota)>, int&>);
+        expect(that % (iota | sr::to<std::vector>()) == std::vector{ 0, 1, 2, 3, 4 });
+
+        auto words = coro_words("the quick brown fox");
+        expect(
+            that % (opt_iter::make(words) | sr::to<std::vector>())
+            == std::vector<std::string>{ "the", "quick", "brown", "fox" }
+        );
+
+        // frames are recycled, creating coroutines in a loop works as expected
+        auto sum = 0;
+        for (auto i : sv::iota(0, 100)) {
+            auto coro = coro_iota(i % 5);
+            for (auto v : opt_iter::make(coro)) {
+                sum += v;
+            }
+        }
+        expect(that % sum == 20 * (0 + 0 + 1 + 3 + 6));
+
+        auto throwing = coro_throwing();
+        auto value    = 0;
+        expect(throwing.next(value) and value == 1);
+        expect(ut::throws([&] { throwing.next(value); }));
+        expect(not throwing.next(value));
+
+        // a frame freed at thread exit after the frame pool of the thread goes to the global allocator
+        auto resumed = false;
+        std::thread{ [&] {
+            thread_local auto held = std::optional<opt_iter::Coro<int>>{};    // destroyed after the pool
+            held.emplace(coro_iota(3));
+            auto first = -1;
+            resumed    = held->next(first) and first == 0;
+        } }.join();
+        expect(resumed);
+    };
+
+    "from_callbacks should turn a push-style producer into an OptIter"_test = [] {
+        // e.g. a parser that calls on_record for each record
+        auto parse = [](int count, const std::function<void(const std::string&)>& on_record) {
+            for (auto i = 0; i < count; ++i) {
+                on_record(std::to_string(i));
+            }
+        };
+
+        auto records = opt_iter::from_callbacks<std::string>([&](auto sink) { parse(1000, sink); }, 4);
+        static_assert(opt_iter::OptIter<decltype(records)>);
+
+        auto all = opt_iter::make(records) | sr::to<std::vector>();
+        expect(that % all.size() == 1000uz);
+        expect(that % all.front() == std::string{ "0" } and that % all.back() == std::string{ "999" });
+
+        // the sink reports that the consumer stopped early, nothing is thrown through the producer
+        auto produced = 0;
+        {
+            auto infinite = opt_iter::from_callbacks<int>(
+                [&](auto sink) {
+                    for (auto i = 0; sink(i); ++i) {
+                        ++produced;
+                    }
+                },
+                2
+            );
+            expect(that % (opt_iter::make(infinite) | sv::take(3) | sr::to<std::vector>()) == std::vector{ 0, 1, 2 });
+        }
+        expect(produced < 10);
+
+        // e.g. a directory walker that asks whether to continue between entries
+        auto polled = 0;
+        {
+            auto walker = opt_iter::from_callbacks<int>(
+                [&](auto sink) {
+                    while (not sink.cancelled()) {
+                        sink(polled++);
+                    }
+                },
+                2
+            );
+            expect(that % walker.next().value() == 0);
+        }
+        expect(polled < 10);
+
+        // unwinding the producer with an exception is opt-in
+        auto unwound = false;
+        {
+            auto throwing = opt_iter::from_callbacks<int, opt_iter::Cancel::Throw>(
+                [&](auto sink) {
+                    auto guard = std::shared_ptr<void>{ nullptr, [&](void*) { unwound = true; } };
+                    for (auto i = 0;; ++i) {
+                        sink(i);
+                    }
+                },
+                2
+            );
+            expect(that % throwing.next().value() == 0);
+        }
+        expect(unwound);
+
+        auto failing = opt_iter::from_callbacks<int>([](auto sink) {
+            sink(1);
+            throw std::runtime_error{ "producer" };
+        });
+        expect(that % failing.next().value() == 1);
+        expect(ut::throws([&] { failing.next(); }));
+        expect(not failing.next().has_value());
+    };
+
+    "drive should push the values through the sink chain and stop early"_test = [] {
+        namespace sink = opt_iter::sink;
+
+        auto is_even = [](int v) { return v % 2 == 0; };
+        auto negate  = [](int v) { return -v; };
+
+        auto counting = CountingSeq{};
+        auto values   = opt_iter::drive(
+            counting, sink::filter(is_even) | sink::map(negate) | sink::take(4) | sink::into_vector()
+        );
+        expect(that % values == std::vector{ 0, -2, -4, -6 });
+        expect(that % counting.calls == 7);    // stops right after the 4th value
+
+        expect(that % opt_iter::drive(IntSeq{ 10 }, sink::sum()) == 45);
+        expect(that % opt_iter::drive(IntSeq{ 10 }, sink::map(negate) | sink::sum(100L)) == 55L);
+        expect(that % opt_iter::drive(IntSeq{ 10 }, sink::take(0) | sink::sum()) == 0);
+
+        auto lengths = opt_iter::drive(
+            coro_words("a bb ccc"), sink::map([](const std::string& w) { return w.size(); }) | sink::into_vector(3)
+        );
+        expect(that % lengths == std::vector<std::size_t>{ 1, 2, 3 });
+    };
+
+    "Pool should recycle the objects yielded through Pooled handles"_test = [] {
+        auto batches = opt_iter::make_owned<PooledBatches>(100);
+        auto objects = std::vector<const std::vector<int>*>{};
+        auto sizes   = std::vector<std::size_t>{};
+
+        for (auto batch : batches) {
+            objects.push_back(batch.get());
+            sizes.push_back(batch->size());
+        }
+        expect(that % sizes[0] == 1uz and that % sizes[3] == 4uz and that % sizes[4] == 1uz);
+
+        // at most two objects are alive at once: the one in the storage and the one being consumed
+        std::ranges::sort(objects);
+        auto [first, last] = std::ranges::unique(objects);
+        objects.erase(first, last);
+        expect(objects.size() <= 2uz);
+
+        auto& pool = batches.underlying().m_pool;
+        expect(that % pool.alive_count() == 0uz);
+
+        // the capacity is kept when the object is reused
+        auto handle   = pool.acquire();
+        auto capacity = handle->capacity();
+        expect(capacity >= 4uz);
+
+        // a handle can outlive its pool
+        auto survivor = opt_iter::Pooled<std::string>{};
+        {
+            auto strings = opt_iter::Pool<std::string>{};
+            survivor     = strings.acquire();
+            *survivor    = "survivor";
+        }
+        expect(that % *survivor == std::string{ "survivor" });
+    };
+
+    "StringArena should keep the yielded views valid until release()"_test = [] {
+        auto arena  = opt_iter::StringArena{ 8 };
+        auto fields = std::vector<std::string_view>{};
+
+        auto input = std::string_view{ "plain;a\\;b;long\\;field\\;spanning\\;blocks;\\\\;" };
+        for (auto field : opt_iter::make_owned<Unescaper>(input, arena)) {
+            fields.push_back(field);
+        }
+        auto expected = std::vector<std::string_view>{ "plain", "a;b", "long;field;spanning;blocks", "\\", "" };
+        expect(that % fields == expected);
+
+        // strings built across a block boundary are moved as a whole
+        auto part    = arena.builder();
+        auto ten     = std::string(10, 'x');
+        part.append(ten);
+        part.append(ten);
+        expect(that % part.finish() == std::string_view{ ten + ten });
+
+        // the blocks are reused after release()
+        auto capacity = arena.capacity();
+        for (auto epoch = 1uz; epoch <= 3; ++epoch) {
+            arena.release();
+            expect(that % arena.epoch() == epoch);
+
+            fields.clear();
+            for (auto field : opt_iter::make_owned<Unescaper>(input, arena)) {
+                fields.push_back(field);
+            }
+            expect(that % fields == expected);
+        }
+        expect(that % arena.capacity() == capacity);
+
+        // released in bulk after each chunk
+        auto many = std::string{ "field\\;0" };
+        for (auto i = 1; i < 100; ++i) {
+            many += ";field\\;" + std::to_string(i);
+        }
+        arena.release();
+        auto count = 0;
+        for (auto chunk : opt_iter::chunks(opt_iter::make_owned<Unescaper>(many, arena), 16)) {
+            for (auto field : chunk) {
+                expect(that % field == "field;" + std::to_string(count++));
+            }
+            arena.release();
+        }
+        expect(that % count == 100);
+    };
+
+    "collect_soa should store each field of the values in its own column"_test = [] {
+        static_assert(opt_iter::Soa<Particle>::field_count == 3);
+        static_assert(std::same_as<opt_iter::Soa<Particle>::Field<2>, std::string>);
+
+        auto to_particle = [](int i) {
+            return Particle{ i, static_cast<float>(i) / 2, std::string(20, static_cast<char>('a' + i)) };
+        };
+        auto particles   = opt_iter::make_owned<IntSeq>(4) | sv::transform(to_particle);
+
+        auto soa = opt_iter::collect_soa<Particle>(particles);
+        expect(that % soa.size() == 4uz);
+        expect(std::ranges::equal(soa.column<0>(), std::array{ 0, 1, 2, 3 }));
+        expect(std::ranges::equal(soa.column<1>(), std::array{ 0.0f, 0.5f, 1.0f, 1.5f }));
+        expect(that % soa.column<2>()[3] == std::string(20, 'd'));
+
+        // sized ranges are reserved up front, lvalues are copied
+        auto source = std::vector{ to_particle(7), to_particle(8) };
+        auto copied = opt_iter::collect_soa<Particle>(source);
+        expect(that % copied.column<0>().size() == 2uz);
+        expect(that % source[1].name == copied.column<2>()[1]);
+
+        // field descriptors for non-aggregates, in the given order
+        using Offset = std::pair<int, int>;
+        auto offsets = opt_iter::collect_soa<&Offset::second, &Offset::first>(opt_iter::make_owned<Stencil>());
+        expect(that % offsets.size() == 9uz);
+        expect(std::ranges::equal(offsets.column<0>(), std::array{ -1, -1, -1, 0, 0, 0, 1, 1, 1 }));
+        expect(std::ranges::equal(offsets.column<1>(), std::array{ -1, 0, 1, -1, 0, 1, -1, 0, 1 }));
+
+        auto empty = opt_iter::collect_soa<Particle>(std::vector<Particle>{});
+        expect(empty.empty());
+    };
+
+    "collect_segmented should grow geometrically without relocating the values"_test = [] {
+        auto values = opt_iter::collect_segmented(opt_iter::make_owned<IntSeq>(100));
+        static_assert(std::ranges::random_access_range<decltype(values)>);
+
+        expect(that % values.size() == 100uz);
+        expect(std::ranges::equal(values, sv::iota(0, 100)));
+        expect(that % values[99] == 99);
+
+        // the addresses are stable while growing
+        auto segmented = opt_iter::Segmented<int>{ 4 };
+        auto* first    = &segmented.emplace_back(0);
+        for (auto i = 1; i < 100; ++i) {
+            segmented.push_back(i);
+        }
+        expect(that % first == &segmented[0]);
+        expect(that % segmented.segment_count() == 5uz);    // 4 + 8 + 16 + 32 + 64
+        expect(that % segmented.segment(1).size() == 8uz and that % segmented.segment(4).size() == 40uz);
+        expect(std::ranges::equal(segmented.segment(1), sv::iota(4, 12)));
+
+        std::ranges::sort(segmented, std::greater{});
+        expect(that % segmented.to_vector() == (sv::iota(0, 100) | sv::reverse | std::ranges::to<std::vector>()));
+
+        // sized ranges fit in a single segment
+        auto source = std::vector<std::string>(1000, "value");
+        auto copied = opt_iter::collect_segmented(source);
+        expect(that % copied.segment_count() == 1uz and that % copied.size() == 1000uz);
+
+        // move-only values are moved out of the segments
+        auto owners = opt_iter::Segmented<std::unique_ptr<int>>{ 2 };
+        for (auto i = 0; i < 10; ++i) {
+            owners.push_back(std::make_unique<int>(i));
+        }
+        auto flat = std::move(owners).to_vector();
+        expect(that % flat.size() == 10uz and that % *flat[9] == 9);
+        expect(owners.empty());
+
+        // segments of at least 2 MiB backed by huge pages
+        auto huge = opt_iter::Segmented<int>{ 1 << 20, opt_iter::Pages::Huge };
+        for (auto i = 0; i < (1 << 20) + 1; ++i) {
+            huge.push_back(i);
+        }
+        expect(that % huge.segment_count() == 2uz and that % huge[1 << 20] == (1 << 20));
+    };
+
+    "simd::filter should yield the same values as views::filter with every instruction set"_test = [] {
+        namespace simd = opt_iter::simd;
+
+        auto rng    = std::mt19937{ 42 };
+        auto ints   = std::vector<int>(1000);
+        auto uints  = std::vector<unsigned>(1000);
+        auto floats = std::vector<float>(1003);
+        std::ranges::generate(ints, [&] { return std::uniform_int_distribution<int>{ -100, 100 }(rng); });
+        std::ranges::generate(uints, [&] { return static_cast<unsigned>(rng()); });
+        std::ranges::generate(floats, [&] { return std::uniform_real_distribution<float>{ -1, 1 }(rng); });
+        floats[10] = std::numeric_limits<float>::quiet_NaN();
+
+        auto check = [](auto& values, auto pred) {
+            auto expected = values | sv::filter(pred) | std::ranges::to<std::vector>();
+            auto actual   = simd::filter(values, pred) | std::ranges::to<std::vector>();
+            if constexpr (std::same_as<std::ranges::range_value_t<decltype(values)>, float>) {
+                // NaN compares unequal to itself
+                return std::ranges::equal(actual, expected, [](float a, float b) {
+                    return a == b or (std::isnan(a) and std::isnan(b));
+                });
+            } else {
+                return actual == expected;
+            }
+        };
+
+        for (auto isa : { simd::Isa::Scalar, simd::Isa::Ssse3, simd::Isa::Avx2 }) {
+            simd::use_isa(isa);
+
+            expect(check(ints, simd::less(0)) and check(ints, simd::less_equal(0)));
+            expect(check(ints, simd::greater(50)) and check(ints, simd::greater_equal(50)));
+            expect(check(ints, simd::equal_to(7)) and check(ints, simd::not_equal_to(7)));
+            expect(check(ints, simd::any_bits(6)) and check(ints, simd::no_bits(1)));
+
+            expect(check(uints, simd::less(1u << 31)) and check(uints, simd::greater_equal(3'000'000'000u)));
+            expect(check(uints, simd::no_bits(3u)));
+
+            expect(check(floats, simd::less(0.5f)) and check(floats, simd::greater_equal(-0.25f)));
+            expect(check(floats, simd::equal_to(floats[3])) and check(floats, simd::not_equal_to(floats[3])));
+
+            // an OptIter parent, the last block is partial
+            auto evens = simd::filter(IntSeq{ 101 }, simd::no_bits(1)) | std::ranges::to<std::vector>();
+            expect(that % evens == (sv::iota(0, 51) | sv::transform([](int v) { return v * 2; })
+                                    | std::ranges::to<std::vector>()));
+        }
+        simd::use_isa(simd::supported_isa());
+
+        // other predicates and value types are filtered with the scalar loop
+        auto doubles = std::vector{ 1.5, -2.0, 3.25, -4.0 };
+        expect(check(doubles, [](double v) { return v > 0; }));
+        expect(check(ints, [](int v) { return v % 3 == 0; }));
+
+        // survivors taken a block at a time, or one by one as an OptIter
+        auto blocks = simd::filter(IntSeq{ 200 }, simd::less(150));
+        auto total  = 0;
+        for (auto block = blocks.next_block(); not block.empty(); block = blocks.next_block()) {
+            expect(block.size() <= decltype(blocks)::block_size);
+            total += std::reduce(block.begin(), block.end());
+        }
+        expect(that % total == 149 * 150 / 2);
+
+        auto odds = simd::filter(IntSeq{ 5 }, simd::any_bits(1));
+        expect(that % odds.next() == std::optional{ 1 } and that % odds.next() == std::optional{ 3 });
+        expect(not odds.next().has_value());
+
+        auto none = simd::filter(IntSeq{ 0 }, simd::less(0));
+        expect(none.begin() == none.end());
+
+        // a read-only buffer is iterated through its const iterator
+        const auto& const_floats = floats;
+        expect(check(const_floats, simd::greater(0.0f)));
+        auto const_total = 0;
+        for (auto value : simd::filter(std::as_const(ints), simd::greater(90))) {
+            const_total += value;
+        }
+        auto large = ints | sv::filter([](int v) { return v > 90; });
+        expect(that % const_total == std::accumulate(large.begin(), large.end(), 0));
+    };
+
+    "rev() and ends() should iterate double-ended iterable from the back and from both ends"_test = [] {
+        static_assert(opt_iter::traits::HasNextBack<IntRange>);
+        static_assert(not opt_iter::traits::HasNextBack<IntSeq>);
+
+        auto owned = opt_iter::make_owned<IntRange, opt_iter::Advance::Lazy>(0, 10);
+        expect(that % (owned.rev() | sr::to<std::vector>()) == (sv::iota(0, 10) | sv::reverse | sr::to<std::vector>()));
+
+        // the value in the storage is handed over to the reversed range
+        auto int_range = IntRange{ 0, 10 };
+        auto range     = opt_iter::make(int_range);
+        expect(that % (range | sv::take(3) | sr::to<std::vector>()) == std::vector{ 0, 1, 2 });
+        expect(that % (range.rev() | sr::to<std::vector>()) == std::vector{ 9, 8, 7, 6, 5, 4, 3 });
+
+        using Pair = std::pair<int, std::optional<int>>;
+
+        auto even = opt_iter::make_owned<IntRange>(0, 4);
+        expect(that % (even.ends() | sr::to<std::vector>()) == std::vector<Pair>{ { 0, 3 }, { 1, 2 } });
+
+        auto odd = opt_iter::make_owned<IntRange>(0, 5);
+        expect(
+            that % (odd.ends() | sr::to<std::vector>())
+            == std::vector<Pair>{ { 0, 4 }, { 1, 3 }, { 2, std::nullopt } }
+        );
+    };
+
     auto int_seq  = IntSeq{ 100 };
     auto int_seq2 = IntSeq2{ 100 };
 